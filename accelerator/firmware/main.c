@@ -3,11 +3,48 @@
 #include <string.h>
 
 #include <irq.h>
+#include <isr.h>
+#include <system.h>
 #include <uart.h>
 #include <console.h>
 #include <generated/csr.h>
+#include <generated/soc.h>
+
+#include <generated/accel_driver.h>
+
+#define ACCEL_N  ACCEL_VECTOR_LEN
+
+/*
+ * Buffers grandes dos testes vão para a main_ram (seção .main_ram_bss do
+ * linker.ld): a sram integrada (8 KiB por padrão) guarda a .bss e a pilha.
+ * Não são zerados no boot; cada teste preenche o que usa.
+ */
+#define MAIN_RAM_BSS __attribute__((section(".bss.main_ram")))
 
 static void produto_escalar(void);
+static void overlap_test(void);
+#ifdef CSR_ACCELERATOR_PERF_RESET_ADDR
+static void perf(char *str);
+#endif
+#ifdef CSR_TIMER0_UPDATE_VALUE_ADDR
+static void bench(char *str);
+static void multi(char *str);
+#endif
+#ifdef CSR_ACCELERATOR_DMA_START_ADDR
+static void produto_escalar_dma(char *str);
+#endif
+#ifdef CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+static void produto_escalar_int8(char *str);
+#endif
+#ifdef CSR_ACCELERATOR_FIFO_JOB_LEN_ADDR
+static void produto_escalar_batch(char *str);
+#endif
+#ifdef CSR_ACCELERATOR_SYSTOLIC_START_ADDR
+static void gemm_test(char *str);
+#endif
+#ifdef ACCEL_FIR_DEPTH
+static void fir_test(char *str);
+#endif
 
 static char *readstr(void)
 {
@@ -74,6 +111,29 @@ static void help(void)
     puts("reboot                          - reboot CPU");
     puts("led                             - led test");
     puts("prod				  - produto escalar");
+    puts("overlap                         - CPU trabalha enquanto o hardware calcula");
+#ifdef CSR_ACCELERATOR_PERF_RESET_ADDR
+    puts("perf [reset]                    - contadores de desempenho do acelerador");
+#endif
+#ifdef CSR_TIMER0_UPDATE_VALUE_ADDR
+    puts("bench <N>                       - ciclos por produto escalar: software x hardware");
+    puts("multi <jobs> <n>                - jobs distribuidos entre as instancias do acelerador");
+#endif
+#ifdef CSR_ACCELERATOR_DMA_START_ADDR
+    puts("dma <n>                         - produto escalar via DMA (n elementos)");
+#endif
+#ifdef CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+    puts("int8 <n>                        - produto escalar int8 via DMA (4 MACs por palavra)");
+#endif
+#ifdef CSR_ACCELERATOR_FIFO_JOB_LEN_ADDR
+    puts("batch <jobs> <n>                - fila de produtos escalares via FIFOs");
+#endif
+#ifdef CSR_ACCELERATOR_SYSTOLIC_START_ADDR
+    puts("gemm <m> <n> <k>                - multiplicacao de matrizes int8 na matriz sistolica");
+#endif
+#ifdef ACCEL_FIR_DEPTH
+    puts("fir <n>                         - filtro FIR em ponto fixo (Q15) sobre n amostras");
+#endif
 }
 
 static void reboot(void)
@@ -83,40 +143,57 @@ static void reboot(void)
 
 static void toggle_led(void)
 {
+#ifdef CSR_LEDS_BASE
     int i;
     printf("invertendo led...\n");
     i = leds_out_read();
     leds_out_write(!i);
+#endif
 }
 
-static int64_t prod_escalar_sw(int32_t *a, int32_t *b)
+static int64_t prod_escalar_sw(int32_t *a, int32_t *b, int n)
 {
     int64_t result = 0;
-    for (int i = 0; i < 8; i++) {
-        result += a[i] * b[i];
+    for (int i = 0; i < n; i++) {
+        result += (int64_t)a[i] * b[i];     // Produto em 64 bits, como no hardware
     }
     return result;
 }
 
+/* Mesmo cálculo com o laço desenrolado em 4 e acumuladores independentes */
+static int64_t prod_escalar_sw_unrolled(const int32_t *a, const int32_t *b, int n)
+{
+    int64_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        acc0 += (int64_t)a[i]     * b[i];
+        acc1 += (int64_t)a[i + 1] * b[i + 1];
+        acc2 += (int64_t)a[i + 2] * b[i + 2];
+        acc3 += (int64_t)a[i + 3] * b[i + 3];
+    }
+    for (; i < n; i++)
+        acc0 += (int64_t)a[i] * b[i];
+    return acc0 + acc1 + acc2 + acc3;
+}
+
 static void produto_escalar(void)
 {
     // Arrays para armazenar os valores lidos da UART
-    int32_t a[8], b[8];
+    static int32_t a[ACCEL_N], b[ACCEL_N];
     int i;
 
     int64_t result;
-    int64_t result_hi;
-    uint32_t result_lo;
 
-    printf("Digite os 8 elementos do vetor A (pressione Enter apos cada numero):\n");
-    for (i = 0; i < 8; i++) {
+    printf("Digite os %d elementos do vetor A (pressione Enter apos cada numero):\n", ACCEL_N);
+    for (i = 0; i < ACCEL_N; i++) {
         printf("A[%d]> ", i);
         scanf("%ld", &a[i]);
 	printf("%ld\n", a[i]);
     }
 
-    printf("\nDigite os 8 elementos do vetor B:\n");
-    for (i = 0; i < 8; i++) {
+    printf("\nDigite os %d elementos do vetor B:\n", ACCEL_N);
+    for (i = 0; i < ACCEL_N; i++) {
         printf("B[%d]> ", i);
 
         scanf("%ld", &b[i]);
@@ -125,42 +202,13 @@ static void produto_escalar(void)
 
     printf("\nValores recebidos. Enviando para o hardware e calculando em software...\n");
     
-    int64_t result_sw = prod_escalar_sw(a, b);
+    int64_t result_sw = prod_escalar_sw(a, b, ACCEL_N);
     
-    // Escrever os dados nos CSRs de entrada
-    accelerator_a0_write(a[0]);
-    accelerator_a1_write(a[1]);
-    accelerator_a2_write(a[2]);
-    accelerator_a3_write(a[3]);
-    accelerator_a4_write(a[4]);
-    accelerator_a5_write(a[5]);
-    accelerator_a6_write(a[6]);
-    accelerator_a7_write(a[7]);
-
-    accelerator_b0_write(b[0]);
-    accelerator_b1_write(b[1]);
-    accelerator_b2_write(b[2]);
-    accelerator_b3_write(b[3]);
-    accelerator_b4_write(b[4]);
-    accelerator_b5_write(b[5]);
-    accelerator_b6_write(b[6]);
-    accelerator_b7_write(b[7]);
-
-    // Habilitar start para começar cálculo
-    accelerator_start_write(1);
+    accel_submit(a, b);
 
     // Aguarda sinal de done
     printf("Aguardando o hardware finalizar...\n");
-    while (!accelerator_done_read()) {
-      printf("%ld", accelerator_done_read());
-    }
-
-    accelerator_start_write(0);
-    
-    // Ler resultado final
-    result_lo = accelerator_result_lo_read();
-    result_hi = (int32_t)accelerator_result_hi_read();
-    result = (result_hi << 32) | result_lo;
+    while (!accel_poll(&result));
 
     // Mostrar o resultado ---
     printf("Hardware finalizou!\n");
@@ -168,6 +216,658 @@ static void produto_escalar(void)
     printf("Produto Escalar em Software= %ld\n", (long)result_sw);
 }
 
+/* Dispara um job e executa trabalho de CPU antes de esperar pelo resultado:
+ * a interrupção de conclusão deve chegar enquanto a CPU ainda está ocupada. */
+static void overlap_test(void)
+{
+    static int32_t a[ACCEL_N], b[ACCEL_N];
+    int64_t result_hw, result_sw;
+    int i, irqs_before, irqs_during, polls;
+
+    for (i = 0; i < ACCEL_N; i++) {
+        a[i] = 1000 * i - 7;
+        b[i] = 3 - 2 * i;
+    }
+
+    irqs_before = accel_irq_count;
+    accel_submit(a, b);
+
+    // Trabalho da CPU enquanto o hardware calcula: a referência em software
+    result_sw = prod_escalar_sw(a, b, ACCEL_N);
+    irqs_during = accel_irq_count - irqs_before;
+
+    polls = 0;
+    while (!accel_poll(&result_hw))
+        polls++;
+
+    printf("IRQs durante o trabalho da CPU: %d, consultas apos o trabalho: %d\n", irqs_during, polls);
+    printf("Hardware = %ld, Software = %ld\n", (long)result_hw, (long)result_sw);
+#ifdef ACCELERATOR_INTERRUPT
+    if (result_hw == result_sw && irqs_during == 1)
+#else
+    if (result_hw == result_sw)
+#endif
+        printf("overlap: OK\n");
+    else
+        printf("overlap: FALHA\n");
+}
+
+#ifdef CSR_ACCELERATOR_PERF_RESET_ADDR
+/* printf sem suporte garantido a long long: imprime um contador de 64 bits em decimal */
+static void print_u64(const char *label, uint64_t v)
+{
+    char buf[21];
+    int i = sizeof(buf) - 1;
+
+    buf[i] = 0;
+    do {
+        buf[--i] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    printf("%-22s%s\n", label, &buf[i]);
+}
+
+/* x * num / den sem estourar 64 bits enquanto num * den couber */
+static uint64_t scale_u64(uint64_t x, uint64_t num, uint64_t den)
+{
+    return x / den * num + x % den * num / den;
+}
+
+/*
+ * Contadores de ciclos do acelerador desde o último `perf reset`. A utilização
+ * é a fração dos ciclos com algum motor ocupado; MAC/s efetivo divide os MACs
+ * pelo tempo total, e MAC/s ocupado apenas pelo tempo em que o hardware
+ * calculava (o pico que a CPU deixou de aproveitar aparece na diferença).
+ */
+static void perf(char *str)
+{
+    uint64_t cycles, busy, stalls, macs;
+    uint32_t jobs, csr_writes;
+
+    if (strcmp(get_token(&str), "reset") == 0) {
+        accelerator_perf_reset_write(1);
+        printf("Contadores zerados\n");
+        return;
+    }
+
+    accelerator_perf_snapshot_write(1);
+    cycles     = accelerator_perf_cycles_read();
+    busy       = accelerator_perf_busy_read();
+    stalls     = accelerator_perf_stalls_read();
+    macs       = accelerator_perf_macs_read();
+    jobs       = accelerator_perf_jobs_read();
+    csr_writes = accelerator_perf_csr_writes_read();
+
+    print_u64("Ciclos:", cycles);
+    print_u64("Ciclos ocupado:", busy);
+    print_u64("Ciclos parado:", stalls);
+    print_u64("Escritas em CSR:", csr_writes);
+    print_u64("Jobs:", jobs);
+    print_u64("MACs:", macs);
+    if (cycles == 0)
+        return;
+    printf("%-22s%lu.%lu%%\n", "Utilizacao:",
+           (unsigned long)(busy * 100 / cycles), (unsigned long)(busy * 1000 / cycles % 10));
+    print_u64("MAC/s efetivo:", scale_u64(macs, CONFIG_CLOCK_FREQUENCY, cycles));
+    if (busy)
+        print_u64("MAC/s ocupado:", scale_u64(macs, CONFIG_CLOCK_FREQUENCY, busy));
+}
+#endif
+
+#ifdef CSR_ACCELERATOR_DMA_START_ADDR
+#define DMA_MAX_LEN 1024
+
+/* Vetores lidos pelo acelerador direto da memória, sem passar pelos CSRs
+ * (na main_ram, também acessível pelo mestre Wishbone do DMA) */
+static int32_t dma_a[DMA_MAX_LEN] MAIN_RAM_BSS, dma_b[DMA_MAX_LEN] MAIN_RAM_BSS;
+static volatile int64_t dma_result __attribute__((aligned(8)));
+
+static int64_t accel_dot_dma(const int32_t *a, const int32_t *b, int n)
+{
+    flush_cpu_dcache();
+
+    accelerator_dma_a_base_write((uint32_t)a);
+    accelerator_dma_b_base_write((uint32_t)b);
+    accelerator_dma_a_stride_write(1);
+    accelerator_dma_b_stride_write(1);
+    accelerator_dma_length_write(n);
+    accelerator_dma_result_base_write((uint32_t)&dma_result);
+    accelerator_dma_start_write(1);
+
+    while (!accelerator_dma_done_read());
+
+    flush_cpu_dcache();
+    return dma_result;
+}
+
+static void produto_escalar_dma(char *str)
+{
+    int i, n;
+    int64_t result_hw, result_sw;
+
+    n = atoi(get_token(&str));
+    if (n <= 0 || n > DMA_MAX_LEN) {
+        printf("Uso: dma <n>, com 1 <= n <= %d\n", DMA_MAX_LEN);
+        return;
+    }
+
+    // Vetores de teste com sinais mistos
+    for (i = 0; i < n; i++) {
+        dma_a[i] = i + 1;
+        dma_b[i] = (i & 1) ? -(3 * i) : 2 * i + 5;
+    }
+
+    result_hw = accel_dot_dma(dma_a, dma_b, n);
+    result_sw = prod_escalar_sw(dma_a, dma_b, n);
+
+    printf("Produto Escalar via DMA    = %ld\n", (long)result_hw);
+    printf("Produto Escalar em Software= %ld\n", (long)result_sw);
+}
+#endif
+
+#ifdef CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+#define INT8_MAX_LEN (4 * DMA_MAX_LEN)
+
+/*
+ * Modo INT8: quatro int8 por palavra (elemento 4w+k no byte k da palavra w).
+ * O hardware soma (a + a_offset) * (b + b_offset) com acumulação em int32,
+ * como o FullyConnected int8 do TFLM. A última palavra é completada com
+ * -a_offset, que não contribui para a soma.
+ */
+static int8_t int8_a[INT8_MAX_LEN] __attribute__((aligned(4))) MAIN_RAM_BSS;
+static int8_t int8_b[INT8_MAX_LEN] __attribute__((aligned(4))) MAIN_RAM_BSS;
+
+static int32_t accel_dot_int8_dma(const int8_t *a, const int8_t *b, int n, int a_offset, int b_offset)
+{
+    int words = (n + 3) / 4;
+    int32_t result;
+
+    accelerator_dma_int8_enable_write(1);
+    accelerator_dma_int8_a_offset_write((uint16_t)a_offset);
+    accelerator_dma_int8_b_offset_write((uint16_t)b_offset);
+    result = (int32_t)accel_dot_dma((const int32_t *)a, (const int32_t *)b, words);
+    accelerator_dma_int8_enable_write(0);
+
+    return result;
+}
+
+static int32_t prod_escalar_int8_sw(const int8_t *a, const int8_t *b, int n, int a_offset, int b_offset)
+{
+    int32_t acc = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+        acc += (a[i] + a_offset) * (b[i] + b_offset);
+    return acc;
+}
+
+static void produto_escalar_int8(char *str)
+{
+    int i, n;
+    int a_offset = 3, b_offset = 128;
+    int32_t result_hw, result_sw;
+
+    n = atoi(get_token(&str));
+    if (n <= 0 || n > INT8_MAX_LEN) {
+        printf("Uso: int8 <n>, com 1 <= n <= %d\n", INT8_MAX_LEN);
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        int8_a[i] = (int8_t)(i * 37 - 100);
+        int8_b[i] = (int8_t)((i & 1) ? -(i % 128) : i % 127);
+    }
+    for (; i & 3; i++) {
+        int8_a[i] = (int8_t)(-a_offset);
+        int8_b[i] = 0;
+    }
+
+    result_hw = accel_dot_int8_dma(int8_a, int8_b, n, a_offset, b_offset);
+    result_sw = prod_escalar_int8_sw(int8_a, int8_b, n, a_offset, b_offset);
+
+    printf("Produto Escalar int8 (HW)  = %ld\n", (long)result_hw);
+    printf("Produto Escalar int8 (SW)  = %ld\n", (long)result_sw);
+}
+#endif
+
+#ifdef CSR_ACCELERATOR_FIFO_JOB_LEN_ADDR
+#define BATCH_MAX_JOBS  64
+#define BATCH_MAX_LEN   256
+#define BATCH_MAX_ELEMS 4096
+
+/* Elementos de teste determinísticos, com sinais mistos */
+static int32_t batch_elem(int job, int i, int which)
+{
+    if (which == 0)
+        return job * 7 + i - 3 * BATCH_MAX_LEN / 2;
+    return (i * 13 + job) % 17 - 8;
+}
+
+static void produto_escalar_batch(char *str)
+{
+    static int64_t results[BATCH_MAX_JOBS];
+    static int32_t a[BATCH_MAX_ELEMS] MAIN_RAM_BSS, b[BATCH_MAX_ELEMS] MAIN_RAM_BSS;
+    int jobs, n, i, j, errors;
+
+    jobs = atoi(get_token(&str));
+    n    = atoi(get_token(&str));
+    if (jobs <= 0 || jobs > BATCH_MAX_JOBS || n <= 0 || n > BATCH_MAX_LEN || n > ACCEL_FIFO_DEPTH ||
+        jobs * n > BATCH_MAX_ELEMS) {
+        printf("Uso: batch <jobs> <n>, com 1 <= jobs <= %d, 1 <= n <= %d (e a profundidade da FIFO, %d)"
+               " e jobs*n <= %d\n", BATCH_MAX_JOBS, BATCH_MAX_LEN, ACCEL_FIFO_DEPTH, BATCH_MAX_ELEMS);
+        return;
+    }
+
+    for (j = 0; j < jobs; j++) {
+        for (i = 0; i < n; i++) {
+            a[j * n + i] = batch_elem(j, i, 0);
+            b[j * n + i] = batch_elem(j, i, 1);
+        }
+    }
+
+    // Todos os jobs são enfileirados sem esperar pelos resultados: o hardware
+    // encadeia os vetores e o driver recolhe os resultados quando a FIFO enche.
+    accel_fifo_dot_many(a, b, n, jobs, n, results);
+
+    // Confere com o cálculo em software
+    errors = 0;
+    for (j = 0; j < jobs; j++) {
+        int64_t expected = prod_escalar_sw(a + j * n, b + j * n, n);
+        if (results[j] != expected) {
+            printf("Job %d: hardware = %ld, software = %ld\n", j, (long)results[j], (long)expected);
+            errors++;
+        }
+    }
+    printf("%d produtos escalares de %d elementos, %d erro(s)\n", jobs, n, errors);
+}
+#endif
+
+#ifdef CSR_ACCELERATOR_SYSTOLIC_START_ADDR
+#define SA_ROWS    ACCELERATOR_SYSTOLIC_ROWS
+#define SA_COLS    ACCELERATOR_SYSTOLIC_COLS
+#define SA_DEPTH   ACCELERATOR_SYSTOLIC_DEPTH
+#define SA_A_WORDS ((SA_ROWS + 3) / 4)
+#define SA_B_WORDS ((SA_COLS + 3) / 4)
+
+/*
+ * Escreve no buffer local as linhas row0..row0+lanes-1 de uma matriz int8
+ * (linhas de `stride` bytes), colunas k0..k0+kl-1: para cada k, uma palavra a
+ * cada quatro linhas, com a linha 4w+r no byte r. Linhas além de `rows` vão
+ * como zero; o resultado correspondente é descartado.
+ */
+static void sa_load(void (*data_write)(uint32_t), const int8_t *mat, int stride, int rows,
+                    int row0, int lanes, int k0, int kl)
+{
+    int k, w, r;
+
+    for (k = k0; k < k0 + kl; k++) {
+        for (w = 0; w < lanes; w += 4) {
+            uint32_t word = 0;
+            for (r = 0; r < 4 && w + r < lanes; r++) {
+                if (row0 + w + r < rows)
+                    word |= (uint32_t)(uint8_t)mat[(row0 + w + r) * stride + k] << (8 * r);
+            }
+            data_write(word);
+        }
+    }
+}
+
+/*
+ * GEMM int8 na matriz sistólica:
+ *     C[i][j] = sum_k (A[i][k] + a_offset) * (B[j][k] + b_offset)
+ * A é m x k e B é n x k, com linhas contíguas (B no layout OHWI dos filtros do
+ * TFLM, e A a matriz im2col da entrada); C é m x n em int32, com a mesma
+ * aritmética modular dos kernels int8. O hardware calcula blocos de
+ * SA_ROWS x SA_COLS; K maior que SA_DEPTH é dividido em passadas acumuladas.
+ * Quando K cabe no buffer, cada bloco de B é carregado uma única vez e
+ * reaproveitado por todas as linhas de A.
+ */
+static void accel_gemm_s8(const int8_t *a, const int8_t *b, int32_t *c, int m, int n, int k,
+                          int a_offset, int b_offset)
+{
+    int i0, j0, k0, kl, i, j;
+
+    accelerator_systolic_a_offset_write((uint16_t)a_offset);
+    accelerator_systolic_b_offset_write((uint16_t)b_offset);
+
+    for (j0 = 0; j0 < n; j0 += SA_COLS) {
+        for (i0 = 0; i0 < m; i0 += SA_ROWS) {
+            for (k0 = 0; k0 < k; k0 += SA_DEPTH) {
+                kl = (k - k0 < SA_DEPTH) ? k - k0 : SA_DEPTH;
+                accelerator_systolic_a_addr_write(0);
+                sa_load(accelerator_systolic_a_data_write, a, k, m, i0, SA_ROWS, k0, kl);
+                if (k > SA_DEPTH || i0 == 0) {
+                    accelerator_systolic_b_addr_write(0);
+                    sa_load(accelerator_systolic_b_data_write, b, k, n, j0, SA_COLS, k0, kl);
+                }
+                accelerator_systolic_k_len_write(kl);
+                accelerator_systolic_accumulate_write(k0 != 0);
+                accelerator_systolic_start_write(1);
+                while (!accelerator_systolic_done_read());
+            }
+            for (i = 0; i < SA_ROWS && i0 + i < m; i++) {
+                for (j = 0; j < SA_COLS && j0 + j < n; j++) {
+                    accelerator_systolic_sel_write(i * SA_COLS + j);
+                    c[(i0 + i) * n + j0 + j] = (int32_t)accelerator_systolic_result_read();
+                }
+            }
+        }
+    }
+}
+
+static void gemm_s8_sw(const int8_t *a, const int8_t *b, int32_t *c, int m, int n, int k,
+                       int a_offset, int b_offset)
+{
+    int i, j, kk;
+
+    for (i = 0; i < m; i++) {
+        for (j = 0; j < n; j++) {
+            int32_t acc = 0;
+            for (kk = 0; kk < k; kk++)
+                acc += (a[i * k + kk] + a_offset) * (b[j * k + kk] + b_offset);
+            c[i * n + j] = acc;
+        }
+    }
+}
+
+#define GEMM_MAX_MN 32
+#define GEMM_MAX_K  512
+
+static void gemm_test(char *str)
+{
+    static int8_t  a[GEMM_MAX_MN * GEMM_MAX_K] MAIN_RAM_BSS, b[GEMM_MAX_MN * GEMM_MAX_K] MAIN_RAM_BSS;
+    static int32_t c_hw[GEMM_MAX_MN * GEMM_MAX_MN] MAIN_RAM_BSS, c_sw[GEMM_MAX_MN * GEMM_MAX_MN] MAIN_RAM_BSS;
+    int a_offset = 5, b_offset = 0;
+    int m, n, k, i, errors;
+
+    m = atoi(get_token(&str));
+    n = atoi(get_token(&str));
+    k = atoi(get_token(&str));
+    if (m <= 0 || m > GEMM_MAX_MN || n <= 0 || n > GEMM_MAX_MN || k <= 0 || k > GEMM_MAX_K) {
+        printf("Uso: gemm <m> <n> <k>, com 1 <= m, n <= %d e 1 <= k <= %d\n", GEMM_MAX_MN, GEMM_MAX_K);
+        return;
+    }
+
+    for (i = 0; i < m * k; i++)
+        a[i] = (int8_t)(i * 37 - 100);
+    for (i = 0; i < n * k; i++)
+        b[i] = (int8_t)((i & 1) ? -(i % 127) : (i * 5) % 128);
+
+    accel_gemm_s8(a, b, c_hw, m, n, k, a_offset, b_offset);
+    gemm_s8_sw(a, b, c_sw, m, n, k, a_offset, b_offset);
+
+    errors = 0;
+    for (i = 0; i < m * n; i++) {
+        if (c_hw[i] != c_sw[i]) {
+            if (errors < 8)
+                printf("C[%d][%d]: hardware = %ld, software = %ld\n", i / n, i % n, (long)c_hw[i], (long)c_sw[i]);
+            errors++;
+        }
+    }
+    printf("GEMM %dx%dx%d em blocos de %dx%d, %d erro(s)\n", m, n, k, SA_ROWS, SA_COLS, errors);
+}
+#endif
+
+#ifdef ACCEL_FIR_DEPTH
+#define FIR_MAX_LEN 1024
+#define FIR_SHIFT   15
+
+/* Referência em software: mesmo arredondamento do hardware */
+static void fir_sw(const int32_t *h, int taps, const int32_t *x, int64_t *y, int n)
+{
+    int64_t acc;
+    int i, k;
+
+    for (i = 0; i < n; i++) {
+        acc = 0;
+        for (k = 0; k < taps && k <= i; k++)
+            acc += (int64_t)h[k] * x[i - k];
+        y[i] = ((acc >> (FIR_SHIFT - 1)) + 1) >> 1;
+    }
+}
+
+/*
+ * fir <n>: passa-baixas de ACCEL_N coeficientes Q15 (janela triangular com
+ * soma 1.0) sobre n amostras de uma dente de serra com ruído, no hardware e
+ * em software.
+ */
+static void fir_test(char *str)
+{
+    static int32_t x[FIR_MAX_LEN] MAIN_RAM_BSS;
+    static int64_t y_hw[FIR_MAX_LEN] MAIN_RAM_BSS, y_sw[FIR_MAX_LEN] MAIN_RAM_BSS;
+    int32_t h[ACCEL_N];
+    int32_t sum = 0;
+    int n, i, errors;
+
+    n = atoi(get_token(&str));
+    if (n <= 0 || n > FIR_MAX_LEN) {
+        printf("Uso: fir <n>, com 1 <= n <= %d\n", FIR_MAX_LEN);
+        return;
+    }
+
+    for (i = 0; i < ACCEL_N; i++) {
+        h[i] = (i < ACCEL_N - i ? i : ACCEL_N - i - 1) + 1;
+        sum += h[i];
+    }
+    for (i = 0; i < ACCEL_N; i++)
+        h[i] = h[i] * (1 << FIR_SHIFT) / sum;
+    for (i = 0; i < n; i++)
+        x[i] = (i % 64) * 512 - 16384 + (int32_t)((0x9e3779b9u * (uint32_t)(i + 1)) >> 22) - 512;
+
+    accel_fir_init(h, ACCEL_N, FIR_SHIFT);
+    accel_fir(x, y_hw, n);
+    accel_fir_end();
+    fir_sw(h, ACCEL_N, x, y_sw, n);
+
+    errors = 0;
+    for (i = 0; i < n; i++) {
+        if (y_hw[i] != y_sw[i]) {
+            if (errors < 8)
+                printf("y[%d]: hardware = %ld, software = %ld\n", i, (long)y_hw[i], (long)y_sw[i]);
+            errors++;
+        }
+    }
+    printf("FIR de %d coeficientes sobre %d amostras, %d erro(s)\n", ACCEL_N, n, errors);
+}
+#endif
+
+#ifdef CSR_TIMER0_UPDATE_VALUE_ADDR
+#define BENCH_SETS 16
+
+/* timer0 em contagem decrescente livre, a partir de 0xffffffff (um tick por ciclo) */
+static void bench_timer_start(void)
+{
+    timer0_en_write(0);
+    timer0_reload_write(0);
+    timer0_load_write(0xffffffff);
+    timer0_en_write(1);
+}
+
+static uint32_t bench_timer_cycles(void)
+{
+    timer0_update_value_write(1);
+    return 0xffffffff - timer0_value_read();
+}
+
+/* Razão x/y com duas casas, sem ponto flutuante */
+static void print_ratio(const char *label, uint32_t x, uint32_t y)
+{
+    uint32_t r = y ? (uint32_t)((uint64_t)x * 100 / y) : 0;
+    printf("%s%lu.%02lux\n", label, (unsigned long)(r / 100), (unsigned long)(r % 100));
+}
+
+/* Caminho pelos CSRs: um conjunto de ACCEL_N elementos por vez */
+static int32_t bench_a[ACCEL_N], bench_b[ACCEL_N];
+static volatile int64_t bench_sink;
+
+/* Conjunto de operandos `set`, gerado por hash a cada uso em vez de guardado */
+static void bench_fill(int32_t *a, int32_t *b, int set, int len)
+{
+    int i;
+
+    for (i = 0; i < len; i++) {
+        a[i] = (int32_t)(0x9e3779b9u * ((uint32_t)set << 16 | (uint32_t)(i + 1)));
+        b[i] = (i & 1) ? -(set * 131 + i) : set * 7 + i * 3;
+    }
+}
+
+enum { BENCH_SW, BENCH_SW_UNROLLED, BENCH_CSR, BENCH_DMA };
+
+/*
+ * Ciclos por produto escalar de `len` elementos em um caminho: as n repetições
+ * são divididas entre os BENCH_SETS conjuntos, e só o cálculo entra na conta,
+ * não a geração de cada conjunto em a/b.
+ */
+static uint32_t bench_run(int path, int32_t *a, int32_t *b, int n, int len)
+{
+    uint32_t total = 0, t0;
+    int64_t result;
+    int s, j, count;
+
+    bench_timer_start();
+    for (s = 0; s < BENCH_SETS; s++) {
+        count = n / BENCH_SETS + (s < n % BENCH_SETS);
+        if (count == 0)
+            break;
+        bench_fill(a, b, s, len);
+        t0 = bench_timer_cycles();
+        switch (path) {
+        case BENCH_SW:
+            for (j = 0; j < count; j++)
+                bench_sink = prod_escalar_sw(a, b, len);
+            break;
+        case BENCH_SW_UNROLLED:
+            for (j = 0; j < count; j++)
+                bench_sink = prod_escalar_sw_unrolled(a, b, len);
+            break;
+        case BENCH_CSR:
+            for (j = 0; j < count; j++) {
+                accel_submit(a, b);
+                while (!accel_poll(&result));
+                bench_sink = result;
+            }
+            break;
+#ifdef CSR_ACCELERATOR_DMA_START_ADDR
+        case BENCH_DMA:
+            for (j = 0; j < count; j++)
+                bench_sink = accel_dot_dma(a, b, len);
+            break;
+#endif
+        }
+        total += bench_timer_cycles() - t0;
+    }
+    return total / n;
+}
+
+/*
+ * bench <N>: N produtos escalares sobre dados gerados em cada caminho, com o
+ * tempo medido em timer0 (ciclos do clock do sistema), incluindo a escrita dos
+ * operandos e a espera pelo resultado no caminho em hardware. Com o front-end
+ * DMA, repete a comparação para vetores de 4 a DMA_MAX_LEN elementos (nos
+ * buffers do DMA) e mostra a partir de qual comprimento o hardware compensa.
+ */
+static void bench(char *str)
+{
+    uint32_t sw, sw_unrolled, hw;
+    int64_t result;
+    int n, j, errors;
+
+    n = atoi(get_token(&str));
+    if (n <= 0) {
+        printf("Uso: bench <N>, com N >= 1\n");
+        return;
+    }
+
+    // Caminho pelos CSRs: vetores de ACCEL_N elementos
+    sw          = bench_run(BENCH_SW, bench_a, bench_b, n, ACCEL_N);
+    sw_unrolled = bench_run(BENCH_SW_UNROLLED, bench_a, bench_b, n, ACCEL_N);
+    hw          = bench_run(BENCH_CSR, bench_a, bench_b, n, ACCEL_N);
+
+    errors = 0;
+    for (j = 0; j < BENCH_SETS && j < n; j++) {
+        bench_fill(bench_a, bench_b, j, ACCEL_N);
+        accel_submit(bench_a, bench_b);
+        while (!accel_poll(&result));
+        if (result != prod_escalar_sw(bench_a, bench_b, ACCEL_N))
+            errors++;
+    }
+
+    printf("%d produtos escalares de %d elementos (ciclos por produto):\n", n, ACCEL_N);
+    printf("  software (int64)       %lu\n", (unsigned long)sw);
+    printf("  software (desenrolado) %lu\n", (unsigned long)sw_unrolled);
+    printf("  hardware (CSRs)        %lu%s\n", (unsigned long)hw, errors ? "  (resultados divergentes!)" : "");
+    print_ratio("  speedup sobre o desenrolado: ", sw_unrolled, hw);
+
+#ifdef CSR_ACCELERATOR_DMA_START_ADDR
+    {
+        int len, crossover = 0;
+
+        printf("Via DMA (ciclos por produto):\n");
+        printf("  %6s %10s %10s %8s\n", "n", "software", "DMA", "speedup");
+        for (len = 4; len <= DMA_MAX_LEN; len *= 2) {
+            uint32_t r;
+
+            sw_unrolled = bench_run(BENCH_SW_UNROLLED, dma_a, dma_b, n, len);
+            hw          = bench_run(BENCH_DMA, dma_a, dma_b, n, len);
+            if (!crossover && hw < sw_unrolled)
+                crossover = len;
+            r = hw ? (uint32_t)((uint64_t)sw_unrolled * 100 / hw) : 0;
+            printf("  %6d %10lu %10lu %5lu.%02lux\n", len, (unsigned long)sw_unrolled, (unsigned long)hw,
+                   (unsigned long)(r / 100), (unsigned long)(r % 100));
+        }
+        if (crossover)
+            printf("O DMA compensa a partir de %d elementos\n", crossover);
+        else
+            printf("O DMA nao superou o software ate %d elementos\n", DMA_MAX_LEN);
+    }
+#endif
+}
+
+#define MULTI_MAX_JOBS  64
+#define MULTI_MAX_ELEMS 1024
+
+/*
+ * multi <jobs> <n>: os mesmos jobs independentes (n elementos cada) passam
+ * pelo dispatcher do driver com 1, 2, ... ACCEL_COUNT instâncias; mostra os
+ * ciclos por job e o ganho sobre uma instância.
+ */
+static void multi(char *str)
+{
+    static int64_t results[MULTI_MAX_JOBS];
+    static int32_t a[MULTI_MAX_ELEMS] MAIN_RAM_BSS, b[MULTI_MAX_ELEMS] MAIN_RAM_BSS;
+    uint32_t cycles, single = 0;
+    int jobs, n, k, j, errors;
+
+    jobs = atoi(get_token(&str));
+    n    = atoi(get_token(&str));
+    if (jobs <= 0 || jobs > MULTI_MAX_JOBS || n <= 0 || jobs * n > MULTI_MAX_ELEMS) {
+        printf("Uso: multi <jobs> <n>, com 1 <= jobs <= %d e jobs*n <= %d\n", MULTI_MAX_JOBS,
+               MULTI_MAX_ELEMS);
+        return;
+    }
+
+    for (j = 0; j < jobs * n; j++) {
+        a[j] = (int32_t)(0x9e3779b9u * (uint32_t)(j + 1));
+        b[j] = (j & 1) ? -(j % 1000) : j % 777;
+    }
+
+    printf("%d jobs de %d elementos, %d instancia(s) (ciclos por job):\n", jobs, n, ACCEL_COUNT);
+    for (k = 1; k <= ACCEL_COUNT; k++) {
+        bench_timer_start();
+        accel_dispatch(a, b, n, jobs, n, results, k);
+        cycles = bench_timer_cycles() / jobs;
+        if (k == 1)
+            single = cycles;
+
+        errors = 0;
+        for (j = 0; j < jobs; j++)
+            if (results[j] != prod_escalar_sw(a + j * n, b + j * n, n))
+                errors++;
+        printf("  %d instancia(s): %6lu%s", k, (unsigned long)cycles, errors ? "  (resultados divergentes!)" : "");
+        print_ratio("  ", single, cycles);
+    }
+}
+#endif
 
 static void console_service(void) {
     char *str;
@@ -185,6 +885,38 @@ static void console_service(void) {
         toggle_led();
     else if(strcmp(token, "prod") == 0)
         produto_escalar();
+    else if(strcmp(token, "overlap") == 0)
+        overlap_test();
+#ifdef CSR_ACCELERATOR_PERF_RESET_ADDR
+    else if(strcmp(token, "perf") == 0)
+        perf(str);
+#endif
+#ifdef CSR_TIMER0_UPDATE_VALUE_ADDR
+    else if(strcmp(token, "bench") == 0)
+        bench(str);
+    else if(strcmp(token, "multi") == 0)
+        multi(str);
+#endif
+#ifdef CSR_ACCELERATOR_DMA_START_ADDR
+    else if(strcmp(token, "dma") == 0)
+        produto_escalar_dma(str);
+#endif
+#ifdef CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+    else if(strcmp(token, "int8") == 0)
+        produto_escalar_int8(str);
+#endif
+#ifdef CSR_ACCELERATOR_FIFO_JOB_LEN_ADDR
+    else if(strcmp(token, "batch") == 0)
+        produto_escalar_batch(str);
+#endif
+#ifdef CSR_ACCELERATOR_SYSTOLIC_START_ADDR
+    else if(strcmp(token, "gemm") == 0)
+        gemm_test(str);
+#endif
+#ifdef ACCEL_FIR_DEPTH
+    else if(strcmp(token, "fir") == 0)
+        fir_test(str);
+#endif
     prompt();
 }
 
@@ -194,9 +926,13 @@ int main(void) {
     irq_setie(1);
 #endif
     uart_init();
+    accel_init();
 
     printf("Hellorld!\n");
     help();
+#ifdef ACCEL_SELFTEST
+    overlap_test();
+#endif
     prompt();
 
     while(1) {
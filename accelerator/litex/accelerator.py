@@ -1,70 +1,1566 @@
+import os
+from functools import reduce
+from operator import or_
+from string import Template
+
 from migen import *
+from migen.genlib.cdc import MultiReg, PulseSynchronizer
 from litex.gen import *
 from litex.soc.interconnect.csr import *
+from litex.soc.interconnect.csr_eventmanager import *
+from litex.soc.interconnect import wishbone
+from litex.soc.interconnect import stream
+
+# Fontes SystemVerilog relativas a este arquivo: o módulo também é usado por outros SoCs
+# (ex.: tflm_litex), executados a partir de outros diretórios.
+RTL_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "rtl")
 
 class Accelerator(LiteXModule):
-    def __init__(self, platform):
-        platform.add_source("rtl/accelerator.sv")
-        
+    def __init__(self, platform, vector_len=8, lanes=None, pipelined=False, with_dma=False, with_fifo=False,
+        with_int8=False, with_requant=False, with_systolic=False, systolic_rows=4, systolic_cols=4,
+        with_sticky=False, with_fir=False, clock_domain="sys"):
+        platform.add_source(os.path.join(RTL_DIR, "accelerator.sv"))
+
+        # Modo bus-master: busca os operandos direto da memória (ver AcceleratorDMA)
+        if with_dma:
+            self.dma = AcceleratorDMA(platform, with_int8=with_int8, with_requant=with_requant)
+
+        # Fila de jobs: operandos e resultados em FIFOs (ver AcceleratorFIFO)
+        if with_fifo:
+            self.fifo = AcceleratorFIFO(platform, with_int8=with_int8, with_requant=with_requant)
+
+        # Multiplicação de matrizes int8 com reuso de operandos (ver AcceleratorSystolic)
+        if with_systolic:
+            self.systolic = AcceleratorSystolic(platform, rows=systolic_rows, cols=systolic_cols)
+
+        # Bias, requantização, offset e saturação em hardware (ver AcceleratorRequant)
+        self.requant = requant = AcceleratorRequant(platform) if with_requant else None
+
+        # Leitura do resultado sem handshake de start/done (ver AcceleratorSticky)
+        self.sticky = sticky = AcceleratorSticky() if with_sticky else None
+
+        # Filtro FIR sobre o mesmo MAC, com linha de atraso no lugar de B (ver AcceleratorFIR)
+        self.fir = fir = AcceleratorFIR(vector_len, pipelined=pipelined) if with_fir else None
+
+        # Por padrão a FSM faz um produto por ciclo e o pipeline processa o vetor inteiro por ciclo.
+        if lanes is None:
+            lanes = vector_len if pipelined else 1
+        assert vector_len % lanes == 0, "lanes deve dividir vector_len"
+        self.vector_len = vector_len
+        self.lanes      = lanes
+        self.pipelined  = pipelined
+        self.clock_domain = clock_domain
+
         self.start_csr = CSRStorage(1, name="start")
-        self.a0 = CSRStorage(32, name="a0"); 
-        self.a1 = CSRStorage(32, name="a1"); 
-        self.a2 = CSRStorage(32, name="a2"); 
-        self.a3 = CSRStorage(32, name="a3"); 
-        self.a4 = CSRStorage(32, name="a4"); 
-        self.a5 = CSRStorage(32, name="a5"); 
-        self.a6 = CSRStorage(32, name="a6"); 
-        self.a7 = CSRStorage(32, name="a7");
-
-        self.b0 = CSRStorage(32, name="b0"); 
-        self.b1 = CSRStorage(32, name="b1"); 
-        self.b2 = CSRStorage(32, name="b2"); 
-        self.b3 = CSRStorage(32, name="b3"); 
-        self.b4 = CSRStorage(32, name="b4"); 
-        self.b5 = CSRStorage(32, name="b5"); 
-        self.b6 = CSRStorage(32, name="b6"); 
-        self.b7 = CSRStorage(32, name="b7"); 
-        
+
+        # Um CSR de 32 bits por elemento (a0..aN-1, b0..bN-1), em endereços contíguos.
+        # Os CSRs são coletados em ordem alfabética dos atributos: os índices têm
+        # zeros à esquerda para que a10 não fique entre a1 e a2.
+        digits = len(str(vector_len - 1))
+        a_csrs = []
+        b_csrs = []
+        for i in range(vector_len):
+            a_csrs.append(CSRStorage(32, name=f"a{i}"))
+            setattr(self, f"a{i:0{digits}d}", a_csrs[-1])
+        for i in range(vector_len):
+            b_csrs.append(CSRStorage(32, name=f"b{i}"))
+            setattr(self, f"b{i:0{digits}d}", b_csrs[-1])
+
         self.done_csr = CSRStatus(1, name="done", description="Pulso de finalização do cálculo")
         self.result_hi_csr = CSRStatus(32, name="result_hi", description="Parte alta (bits 63-32) do resultado.")
         self.result_lo_csr = CSRStatus(32, name="result_lo", description="Parte baixa (bits 31-0) do resultado.")
-        
+
         # Sinais Internos
         start_sig  = Signal()
         done_sig   = Signal()
-        a_sig     = [Signal(32, name=f"a{i}_sig") for i in range(8)]
-        b_sig     = [Signal(32, name=f"b{i}_sig") for i in range(8)]
+        a_sig      = Signal(32*vector_len)
+        b_sig      = Signal(32*vector_len)
         result_sig = Signal(64)
 
+        # Núcleo em outro domínio de clock: o restante do bloco (CSRs, front-ends,
+        # requantização, FIR) continua em `sys` e só o handshake cruza (ver AcceleratorCDC)
+        if clock_domain != "sys":
+            self.cdc = cdc = AcceleratorCDC(clock_domain, pipelined)
+            self.comb += [
+                cdc.start.eq(start_sig),
+                done_sig.eq(cdc.done),
+                result_sig.eq(cdc.result),
+            ]
+            core_start, core_done, core_result = cdc.core_start, cdc.core_done, cdc.core_result
+        else:
+            core_start, core_done, core_result = start_sig, done_sig, result_sig
+
         # Instanciação do Módulo SystemVerilog
         self.specials += Instance("accelerator",
-            i_clk=ClockSignal(),
-            i_rst=ResetSignal(),
-            i_start=start_sig,
-            i_a0=a_sig[0], i_a1=a_sig[1], i_a2=a_sig[2], i_a3=a_sig[3],
-            i_a4=a_sig[4], i_a5=a_sig[5], i_a6=a_sig[6], i_a7=a_sig[7],
-            i_b0=b_sig[0], i_b1=b_sig[1], i_b2=b_sig[2], i_b3=b_sig[3],
-            i_b4=b_sig[4], i_b5=b_sig[5], i_b6=b_sig[6], i_b7=b_sig[7],
-            o_done=done_sig,
-            o_result=result_sig,
-        )
-        
+            p_VECTOR_LEN=vector_len,
+            p_LANES=lanes,
+            p_PIPELINED=int(pipelined),
+            i_clk=ClockSignal(clock_domain),
+            i_rst=ResetSignal(clock_domain),
+            i_start=core_start,
+            i_a=a_sig,
+            i_b=b_sig,
+            o_done=core_done,
+            o_result=core_result,
+        )
+
+        # O FIR usa a saída do MAC, antes da requantização
+        if fir is not None:
+            self.comb += [
+                fir.done.eq(done_sig),
+                fir.result.eq(result_sig),
+            ]
+
+        # Com requantização, `done` e o resultado passam pelo estágio de saída
+        if requant is not None:
+            core_done   = done_sig
+            core_result = result_sig
+            done_sig    = Signal()
+            result_sig  = Signal(64)
+            self.comb += [
+                requant.sink_acc.eq(core_result),
+                result_sig.eq(requant.source_data),
+            ]
+            if pipelined:
+                self.comb += [
+                    requant.sink_valid.eq(core_done),
+                    done_sig.eq(requant.source_valid),
+                ]
+            else:
+                # No modo FSM `done` é um nível mantido até start=0: só a subida entra no
+                # estágio, e o `done` requantizado desce junto com o do núcleo. Atrasar a
+                # descida em `requant.latency` ciclos deixaria um `start` logo em seguida
+                # (ex.: modo sticky) ver o `done` e o resultado do job anterior.
+                core_done_d = Signal()
+                rq_done     = Signal()
+                self.sync += [
+                    core_done_d.eq(core_done),
+                    If(~core_done,
+                        rq_done.eq(0)
+                    ).Elif(requant.source_valid,
+                        rq_done.eq(1)
+                    )
+                ]
+                self.comb += [
+                    requant.sink_valid.eq(core_done & ~core_done_d),
+                    done_sig.eq(core_done & (rq_done | requant.source_valid)),
+                ]
+
+        # No modo em pipeline o `start` do núcleo é um strobe de entrada válida e
+        # `done` é um pulso de um ciclo. Para manter o mesmo protocolo do firmware
+        # (escreve start=1, espera done, escreve start=0), cada escrita de 1 no CSR
+        # gera um único pulso e `done` fica travado até a próxima escrita em start.
+        if pipelined:
+            done_latched = Signal()
+            self.sync += [
+                If(self.start_csr.re, done_latched.eq(0)),
+                If(done_sig, done_latched.eq(1)),
+            ]
+            csr_start = self.start_csr.re & self.start_csr.storage
+            self.comb += self.done_csr.status.eq(done_latched)
+        else:
+            core_start = self.start_csr.storage
+            # No modo sticky o `start` do núcleo fica alto só até `done`: a FSM volta
+            # a IDLE sozinha, sem esperar a CPU escrever 0.
+            if sticky is not None:
+                held = Signal()
+                self.sync += If(self.start_csr.re & self.start_csr.storage,
+                    held.eq(1)
+                ).Elif(done_sig,
+                    held.eq(0)
+                )
+                core_start = Mux(sticky.enable.storage, held, self.start_csr.storage)
+            csr_start = core_start
+            self.comb += self.done_csr.status.eq(done_sig)
+
         # Lógica Combinacional para Conectar CSRs aos Sinais
+        b_window = Cat(*[csr.storage for csr in b_csrs])
+        if fir is not None:
+            # Em modo FIR, A guarda os coeficientes e o sequenciador do FIR dispara o núcleo
+            self.comb += [
+                start_sig.eq(Mux(fir.enable.storage, fir.start, csr_start)),
+                b_sig.eq(Mux(fir.enable.storage, fir.delay, b_window)),
+            ]
+        else:
+            self.comb += [
+                start_sig.eq(csr_start),
+                b_sig.eq(b_window),
+            ]
         self.comb += [
-            start_sig.eq(self.start_csr.storage),
-
-            a_sig[0].eq(self.a0.storage), a_sig[1].eq(self.a1.storage),
-            a_sig[2].eq(self.a2.storage), a_sig[3].eq(self.a3.storage),
-            a_sig[4].eq(self.a4.storage), a_sig[5].eq(self.a5.storage),
-            a_sig[6].eq(self.a6.storage), a_sig[7].eq(self.a7.storage),
- 
-            b_sig[0].eq(self.b0.storage), b_sig[1].eq(self.b1.storage),
-            b_sig[2].eq(self.b2.storage), b_sig[3].eq(self.b3.storage),
-            b_sig[4].eq(self.b4.storage), b_sig[5].eq(self.b5.storage),
-            b_sig[6].eq(self.b6.storage), b_sig[7].eq(self.b7.storage),
-            
-            self.done_csr.status.eq(done_sig),
+            a_sig.eq(Cat(*[csr.storage for csr in a_csrs])),
+
             # Conecta as duas partes do resultado de 64 bits aos CSRs de 32 bits
             self.result_lo_csr.status.eq(result_sig[0:32]),
             self.result_hi_csr.status.eq(result_sig[32:64]),
         ]
+
+        # Interrupções ---------------------------------------------------------------------------
+        # Uma linha de IRQ para o bloco; cada fonte é habilitada em `ev_enable`.
+        self.ev = EventManager()
+        self.ev.done = EventSourcePulse(description="Cálculo finalizado (borda de subida de `done`).")
+        if with_dma:
+            self.ev.dma_done = EventSourcePulse(description="Resultado do DMA escrito na memória.")
+        if with_fifo:
+            self.ev.results = EventSourceLevel(description="Há resultados na FIFO de saída.")
+        if with_systolic:
+            self.ev.systolic_done = EventSourcePulse(description="Bloco da matriz sistólica calculado.")
+        self.ev.finalize()
+
+        done_d    = Signal()
+        done_rise = Signal()
+        self.sync += done_d.eq(self.done_csr.status)
+        self.comb += [
+            done_rise.eq(self.done_csr.status & ~done_d),
+            self.ev.done.trigger.eq(done_rise),
+        ]
+        # Os jobs do FIR não são jobs da CPU: não geram IRQ nem avançam o tag sticky
+        if fir is not None:
+            self.comb += If(fir.enable.storage, done_rise.eq(0))
+        if with_dma:
+            dma_done_d    = Signal()
+            dma_done_rise = Signal()
+            self.sync += dma_done_d.eq(self.dma.done_csr.status)
+            self.comb += [
+                dma_done_rise.eq(self.dma.done_csr.status & ~dma_done_d),
+                self.ev.dma_done.trigger.eq(dma_done_rise),
+            ]
+        if with_fifo:
+            self.comb += self.ev.results.trigger.eq(self.fifo.results.status != 0)
+        if with_systolic:
+            self.comb += self.ev.systolic_done.trigger.eq(self.systolic.done_pulse)
+        if sticky is not None:
+            self.comb += [
+                sticky.start.eq(self.start_csr.re & self.start_csr.storage),
+                sticky.job_done.eq(done_rise),
+                sticky.result.eq(result_sig),
+            ]
+
+        # Contadores de desempenho ---------------------------------------------------------------
+        # O núcleo fica ocupado do `start` até a subida de `done` e faz vector_len MACs por job.
+        core_busy = Signal()
+        self.sync += If(self.start_csr.re & self.start_csr.storage,
+            core_busy.eq(1)
+        ).Elif(done_rise,
+            core_busy.eq(0)
+        )
+        busy  = [core_busy]
+        stall = []
+        jobs  = [done_rise]
+        macs  = [Mux(done_rise, vector_len, 0)]
+        if with_dma:
+            busy  += [self.dma.busy]
+            stall += [self.dma.stall]
+            jobs  += [dma_done_rise]
+            macs  += [self.dma.macs]
+        if with_fifo:
+            busy  += [self.fifo.busy]
+            stall += [self.fifo.stall]
+            jobs  += [self.fifo.job]
+            macs  += [self.fifo.macs]
+        if with_systolic:
+            busy  += [self.systolic.busy]
+            jobs  += [self.systolic.done_pulse]
+            macs  += [self.systolic.macs]
+        if fir is not None:
+            busy  += [self.fir.busy]
+            jobs  += [self.fir.job]
+            macs  += [Mux(self.fir.job, vector_len, 0)]
+
+        csr_write = Signal()
+        self.perf = AcceleratorPerf(
+            busy  = reduce(or_, busy),
+            stall = reduce(or_, stall) if stall else 0,
+            jobs  = sum(jobs),
+            macs  = sum(macs),
+            csr_write = csr_write,
+        )
+        # Ciclos com escrita em qualquer CSR do bloco (operandos, parâmetros, start...)
+        self.comb += csr_write.eq(reduce(or_, [csr.re for csr in self.get_csrs() if isinstance(csr, CSRStorage)]))
+
+    def generate_driver(self, directory, extra_instances=[]):
+        """Gera o driver em C (`accel_driver.h`/`accel_driver.c`) em `directory`.
+
+        Chamado pelos scripts do SoC com o diretório `generated/` do Builder, ao
+        lado do `csr.h`: o driver é compartilhado pelo firmware do acelerador e
+        pelos kernels do TFLM e reflete a configuração do bloco (tamanho do
+        vetor, FIFO e os modos que precisam ser desligados nela).
+        `extra_instances` lista os nomes das regiões de CSR de outras instâncias
+        do núcleo (mesmo `vector_len`), usadas pelo dispatcher do driver.
+        """
+        # A janela de operandos supõe a0..aN-1 seguidos de b0..bN-1, um CSR por palavra
+        names  = [csr.name for csr in self.get_csrs()]
+        window = [f"a{i}" for i in range(self.vector_len)] + [f"b{i}" for i in range(self.vector_len)]
+        first  = names.index("a0")
+        assert names[first:first + len(window)] == window, "CSRs a0..aN-1/b0..bN-1 fora de ordem"
+
+        fifo = getattr(self, "fifo", None)
+        fifo_modes = ""
+        if fifo is not None and fifo.int8 is not None:
+            fifo_modes += "    accelerator_fifo_int8_enable_write(0);\n"
+        if fifo is not None and fifo.requant is not None:
+            fifo_modes += "    accelerator_fifo_requant_enable_write(0);\n"
+        # Tabela de registradores por instância; a instância 0 é este bloco (`accelerator`)
+        regs = ""
+        for name in ["accelerator"] + list(extra_instances):
+            csr = f"CSR_{name.upper()}"
+            regs += f"    {{{csr}_A0_ADDR, {csr}_B0_ADDR, {csr}_START_ADDR, {csr}_DONE_ADDR, {csr}_RESULT_LO_ADDR, {csr}_RESULT_HI_ADDR}},\n"
+        params = dict(
+            count      = 1 + len(extra_instances),
+            regs       = regs,
+            vector_len = self.vector_len,
+            lanes      = self.lanes,
+            pipelined  = int(self.pipelined),
+            fifo_depth = "" if fifo is None else f"#define ACCEL_FIFO_DEPTH  {fifo.depth}\n",
+            fir_depth  = "" if self.fir is None else f"#define ACCEL_FIR_DEPTH   {self.fir.depth}\n",
+            fifo_modes = fifo_modes,
+            sticky     = int(self.sticky is not None),
+        )
+        os.makedirs(directory, exist_ok=True)
+        for name, template in [("accel_driver.h", _DRIVER_H), ("accel_driver.c", _DRIVER_C)]:
+            with open(os.path.join(directory, name), "w") as f:
+                f.write(Template(template).substitute(params))
+
+# Página de CSR ------------------------------------------------------------------------------------
+
+def accel_csr_paging(accelerators, csr_paging=0x800):
+    """Página de CSR (`csr_paging` do SoC) que comporta a região de cada acelerador.
+
+    Soma os CSRs realmente gerados (vetores A/B, front-ends, eventos, FIR, contadores...) em
+    palavras de 32 bits; deve ser chamada antes do SoCCore.__init__, com os aceleradores já
+    construídos, e nunca reduz a página recebida.
+    """
+    for accelerator in accelerators:
+        csr_bytes = 4*sum((csr.size + 31)//32 for csr in accelerator.get_csrs())
+        if csr_bytes > csr_paging:
+            csr_paging = 1 << (csr_bytes - 1).bit_length()
+    return csr_paging
+
+# Travessia de domínio de clock -------------------------------------------------------------------
+
+class AcceleratorCDC(LiteXModule):
+    """Handshake start/done entre `sys` e o domínio do núcleo (`clock_domain`).
+
+    Do lado `sys` o protocolo é o do núcleo sem CDC: no modo FSM `start` é um
+    nível e `done` fica alto até `start` baixar; no pipeline os dois são pulsos.
+    Só pulsos cruzam os domínios (PulseSynchronizer, por toggle): a subida de
+    `start` vira um `start` de nível no núcleo até o fim do cálculo, e o fim do
+    cálculo volta como um pulso, um ciclo depois de o resultado ser capturado
+    em um registrador do domínio do núcleo.
+
+    Os operandos (a0..aN-1, b0..bN-1 ou a linha de atraso do FIR) não passam por
+    sincronizadores: são escritos antes de `start` e ficam estáveis até `done`,
+    e o pulso de `start` leva dois ciclos do núcleo para cruzar. Pelo mesmo
+    motivo o resultado capturado é lido diretamente em `sys`.
+    """
+    def __init__(self, clock_domain, pipelined=False):
+        # Lado sys
+        self.start  = Signal()
+        self.done   = Signal()
+        self.result = Signal(64)
+
+        # Lado do núcleo
+        self.core_start  = Signal()
+        self.core_done   = Signal()
+        self.core_result = Signal(64)
+
+        # # #
+
+        start_ps = PulseSynchronizer("sys", clock_domain)
+        done_ps  = PulseSynchronizer(clock_domain, "sys")
+        self.submodules += start_ps, done_ps
+
+        sync_core = getattr(self.sync, clock_domain)
+
+        # Sys -> núcleo: um pulso por job
+        start_d = Signal()
+        self.sync += start_d.eq(self.start)
+        self.comb += start_ps.i.eq(self.start if pipelined else self.start & ~start_d)
+
+        # No núcleo: o pulso vira `start` de nível até `done` (modo FSM)
+        if pipelined:
+            self.comb += self.core_start.eq(start_ps.o)
+        else:
+            held = Signal()
+            sync_core += If(start_ps.o,
+                held.eq(1)
+            ).Elif(self.core_done,
+                held.eq(0)
+            )
+            self.comb += self.core_start.eq(held)
+
+        # Núcleo -> sys: captura o resultado na subida de `done` e avisa no ciclo seguinte
+        core_done_d = Signal()
+        done_pulse  = Signal()
+        result      = Signal(64)
+        sync_core += [
+            core_done_d.eq(self.core_done),
+            done_pulse.eq(self.core_done & ~core_done_d),
+            If(self.core_done & ~core_done_d, result.eq(self.core_result)),
+        ]
+        self.comb += [
+            done_ps.i.eq(done_pulse),
+            self.result.eq(result),
+        ]
+
+        # No lado sys, `done` de nível (modo FSM) vale até `start` baixar
+        if pipelined:
+            self.comb += self.done.eq(done_ps.o)
+        else:
+            done = Signal()
+            self.sync += If(~self.start,
+                done.eq(0)
+            ).Elif(done_ps.o,
+                done.eq(1)
+            )
+            self.comb += self.done.eq(done)
+
+# FIR ----------------------------------------------------------------------------------------------
+
+class AcceleratorFIR(LiteXModule):
+    """Filtro FIR (convolução 1D) de `taps` coeficientes sobre o MAC do produto escalar.
+
+    y[n] = sum_k h[k] * x[n-k], com h[k] em `a<k>` (coeficientes carregáveis) e
+    uma linha de atraso interna no lugar do vetor B: x[n] no elemento 0, x[n-k]
+    no elemento k. Com `enable` em 1, cada amostra escrita em `sample` entra em
+    uma FIFO; o sequenciador desloca a linha de atraso, dispara o núcleo e
+    empilha uma saída por amostra na FIFO de saída (`outputs`, `output_lo`/
+    `output_hi`, `output_pop`). A saída é o acumulador de 64 bits dividido por
+    2^`shift` com arredondamento (ponto fixo Q: `shift` = bits fracionários dos
+    coeficientes). `clear` zera a linha de atraso e esvazia as FIFOs.
+    """
+    def __init__(self, taps, pipelined=False, depth=64):
+        self.depth = depth
+
+        self.enable     = CSRStorage(1,  name="enable",     description="1: B vem da linha de atraso e o núcleo é disparado pelo sequenciador do FIR.")
+        self.clear      = CSRStorage(1,  name="clear",      description="Escrever 1 zera a linha de atraso e esvazia as FIFOs.")
+        self.shift      = CSRStorage(6,  name="shift",      description="Deslocamento à direita, com arredondamento, de cada saída.")
+        self.sample     = CSRStorage(32, name="sample",     description="Escrita empilha uma amostra de entrada.")
+        self.space      = CSRStatus(16,  name="space",      description="Posições livres na FIFO de amostras.")
+        self.outputs    = CSRStatus(16,  name="outputs",    description="Saídas disponíveis.")
+        self.output_hi  = CSRStatus(32,  name="output_hi",  description="Parte alta (bits 63-32) da saída mais antiga.")
+        self.output_lo  = CSRStatus(32,  name="output_lo",  description="Parte baixa (bits 31-0) da saída mais antiga.")
+        self.output_pop = CSRStorage(1,  name="output_pop", description="Escrever 1 descarta a saída mais antiga.")
+
+        # Ligados pelo Accelerator ao núcleo
+        self.delay  = Signal(32*taps)
+        self.start  = Signal()
+        self.done   = Signal()
+        self.result = Signal((64, True))
+
+        # Contadores de desempenho
+        self.busy = Signal()
+        self.job  = Signal()
+
+        # FIFOs
+        clear = Signal()
+        self.in_fifo  = in_fifo  = ResetInserter()(stream.SyncFIFO([("data", 32)], depth, buffered=True))
+        self.out_fifo = out_fifo = ResetInserter()(stream.SyncFIFO([("data", 64)], depth, buffered=True))
+        self.comb += [
+            clear.eq(self.clear.re & self.clear.storage),
+            in_fifo.reset.eq(clear),
+            out_fifo.reset.eq(clear),
+        ]
+
+        # Saída em ponto fixo: result / 2^shift, arredondando a metade para cima
+        shift   = self.shift.storage
+        rounded = Signal((64, True))
+        self.comb += If(shift == 0,
+            rounded.eq(self.result)
+        ).Else(
+            rounded.eq(((self.result >> (shift - 1)) + 1) >> 1)
+        )
+
+        # Uma amostra por vez: desloca a linha de atraso, dispara o núcleo e guarda a
+        # saída. Os operandos ficam estáveis durante o cálculo e a FIFO de saída
+        # sempre tem lugar para o resultado em voo. O `clear` também zera `delay`.
+        self.fsm = fsm = ResetInserter()(FSM(reset_state="IDLE"))
+        self.comb += fsm.reset.eq(clear)
+        fsm.act("IDLE",
+            If(self.enable.storage & in_fifo.source.valid & out_fifo.sink.ready,
+                in_fifo.source.ready.eq(1),
+                NextValue(self.delay, Cat(in_fifo.source.data, self.delay[:-32])),
+                NextState("START")
+            )
+        )
+        fsm.act("START",
+            self.start.eq(1),
+            NextState("CALC")
+        )
+        # A FSM do núcleo precisa de `start` alto até `done`; o pipeline, de um pulso
+        fsm.act("CALC",
+            self.start.eq(not pipelined),
+            If(self.done,
+                out_fifo.sink.valid.eq(1),
+                out_fifo.sink.data.eq(rounded),
+                NextState("IDLE" if pipelined else "RELEASE")
+            )
+        )
+        if not pipelined:
+            fsm.act("RELEASE",
+                If(~self.done, NextState("IDLE"))
+            )
+        self.comb += [
+            self.busy.eq(~fsm.ongoing("IDLE")),
+            self.job.eq(fsm.ongoing("CALC") & self.done),
+        ]
+
+        # Lógica Combinacional para Conectar CSRs às FIFOs
+        self.comb += [
+            If(self.sample.re,
+                in_fifo.sink.valid.eq(1),
+                in_fifo.sink.data.eq(self.sample.storage),
+            ),
+            out_fifo.source.ready.eq(self.output_pop.re & self.output_pop.storage),
+
+            self.space.status.eq(depth - in_fifo.level),
+            self.outputs.status.eq(out_fifo.level),
+            self.output_lo.status.eq(out_fifo.source.data[0:32]),
+            self.output_hi.status.eq(out_fifo.source.data[32:64]),
+        ]
+
+# Resultado sticky ---------------------------------------------------------------------------------
+
+class AcceleratorSticky(LiteXModule):
+    """Leitura do resultado sem a volta DONE->IDLE (modo sticky).
+
+    Com `enable` em 1, cada escrita de 1 em `start` dispara um job e o `start`
+    do núcleo baixa sozinho no fim do cálculo: a CPU não escreve mais 0 entre
+    jobs. O resultado de 64 bits de cada job fica em um buffer duplo, `result0`
+    ou `result1` pela paridade do tag, e `status` traz em uma única leitura o
+    fim do job (bit 0) e o tag do último job concluído (bits 15:8, contagem
+    módulo 256). O próximo job pode começar assim que o status indica o fim,
+    enquanto o resultado anterior ainda é lido.
+    """
+    def __init__(self):
+        self.enable  = CSRStorage(1,  name="enable",  description="1: `start` vira um disparo e o núcleo volta a IDLE sozinho.")
+        self.status  = CSRStatus(16,  name="status",  description="Bit 0: nenhum job em andamento; bits 15:8: tag do último job concluído.")
+        self.result0 = CSRStatus(64,  name="result0", description="Resultado dos jobs de tag par.")
+        self.result1 = CSRStatus(64,  name="result1", description="Resultado dos jobs de tag ímpar.")
+
+        # Ligados pelo Accelerator
+        self.start    = Signal()    # Escrita de 1 em `start`
+        self.job_done = Signal()    # Subida de `done`
+        self.result   = Signal(64)
+
+        tag       = Signal(8)
+        in_flight = Signal()
+        self.sync += [
+            If(self.start,
+                in_flight.eq(1)
+            ).Elif(self.job_done,
+                in_flight.eq(0)
+            ),
+            If(self.job_done,
+                tag.eq(tag + 1),
+                If(tag[0],
+                    self.result0.status.eq(self.result)
+                ).Else(
+                    self.result1.status.eq(self.result)
+                )
+            ),
+        ]
+        self.comb += self.status.status.eq(Cat(~in_flight, Constant(0, 7), tag))
+
+# Desempenho ---------------------------------------------------------------------------------------
+
+class AcceleratorPerf(LiteXModule):
+    """Contadores de ciclos livres do acelerador, para medir utilização e MAC/s.
+
+    Contam desde o último `reset`: ciclos totais, ciclos com algum motor ocupado,
+    ciclos parados esperando o barramento ou os operandos, jobs concluídos, MACs
+    executados e ciclos com escrita em CSRs do bloco. Uma escrita em `snapshot`
+    copia todos os contadores de uma vez para os CSRs de leitura, de modo que as
+    leituras de 64 bits (duas palavras) são coerentes entre si.
+    """
+    def __init__(self, busy, stall, jobs, macs, csr_write):
+        self.reset      = CSRStorage(1, name="reset",    description="Escrever 1 zera todos os contadores.")
+        self.snapshot   = CSRStorage(1, name="snapshot", description="Escrever 1 copia os contadores para os CSRs de leitura.")
+        self.cycles     = CSRStatus(64, name="cycles",     description="Ciclos desde o reset dos contadores.")
+        self.busy       = CSRStatus(64, name="busy",       description="Ciclos com algum motor do acelerador ocupado.")
+        self.stalls     = CSRStatus(64, name="stalls",     description="Ciclos com trabalho pendente esperando o barramento (DMA) ou operandos/espaço (FIFO).")
+        self.jobs       = CSRStatus(32, name="jobs",       description="Jobs concluídos (produtos escalares, resultados da FIFO, blocos da matriz sistólica).")
+        self.macs       = CSRStatus(64, name="macs",       description="Multiplicações-acumulações executadas.")
+        self.csr_writes = CSRStatus(32, name="csr_writes", description="Ciclos com escrita em CSRs do acelerador.")
+
+        # Sinais Internos
+        clear  = Signal()
+        counts = [
+            (self.cycles,     1),
+            (self.busy,       busy),
+            (self.stalls,     stall),
+            (self.jobs,       jobs),
+            (self.macs,       macs),
+            (self.csr_writes, csr_write),
+        ]
+
+        self.comb += clear.eq(self.reset.re & self.reset.storage)
+        for csr, inc in counts:
+            count = Signal(len(csr.status))
+            self.sync += [
+                If(clear,
+                    count.eq(0)
+                ).Else(
+                    count.eq(count + inc)
+                ),
+                If(self.snapshot.re & self.snapshot.storage,
+                    csr.status.eq(count)
+                ),
+            ]
+
+# INT8 ---------------------------------------------------------------------------------------------
+
+class AcceleratorInt8Config(LiteXModule):
+    """CSRs do modo INT8 de `accelerator_stream` (quatro int8 por palavra de 32 bits).
+
+    Com `enable` em 1 os comprimentos passam a contar palavras (4 elementos cada);
+    uma palavra final incompleta deve ser completada com bytes -a_offset em A,
+    que contribuem com produto zero.
+    """
+    def __init__(self):
+        self.enable   = CSRStorage(1,  name="enable",   description="1: cada palavra carrega quatro valores int8.")
+        self.a_offset = CSRStorage(16, name="a_offset", description="Somado a cada int8 de A (weights_offset no TFLM).")
+        self.b_offset = CSRStorage(16, name="b_offset", description="Somado a cada int8 de B (input_offset no TFLM).")
+
+    def stream_params(self):
+        return dict(
+            p_INT8=1,
+            i_int8_mode=self.enable.storage,
+            i_a_offset=self.a_offset.storage,
+            i_b_offset=self.b_offset.storage,
+        )
+
+def _stream_int8_params(config):
+    # Sem o modo INT8, os multiplicadores de 8 bits não são sintetizados.
+    if config is None:
+        return dict(p_INT8=0, i_int8_mode=0, i_a_offset=0, i_b_offset=0)
+    return config.stream_params()
+
+# Requantização ------------------------------------------------------------------------------------
+
+class AcceleratorRequant(LiteXModule):
+    """Estágio de saída opcional: converte o acumulador em uma ativação final do TFLM.
+
+    Com `enable` em 1, cada resultado passa por `accelerator_requant`:
+    clamp(MultiplyByQuantizedMultiplier(acc + bias, multiplier, shift) + output_offset,
+    act_min, act_max), bit a bit igual a tensorflow/lite/kernels/internal/common.cc
+    (`single_rounding` seleciona a variante TFLITE_SINGLE_ROUNDING). O resultado
+    é estendido com sinal para 64 bits. Com `enable` em 0 o acumulador passa
+    direto, sem latência extra. Os CSRs devem ficar estáveis durante um job.
+    """
+    def __init__(self, platform, single_rounding=False):
+        platform.add_source(os.path.join(RTL_DIR, "accelerator_requant.sv"))
+
+        self.enable        = CSRStorage(1,  name="enable",        description="1: o resultado é a ativação requantizada.")
+        self.bias          = CSRStorage(32, name="bias",          description="Somado ao acumulador (int32) antes da requantização.")
+        self.multiplier    = CSRStorage(32, name="multiplier",    description="quantized_multiplier (ponto fixo no bit 31, >= 0).")
+        self.shift         = CSRStorage(8,  name="shift",         description="Expoente de MultiplyByQuantizedMultiplier (-31..30).")
+        self.output_offset = CSRStorage(32, name="output_offset", description="Somado após a requantização (zero point da saída).")
+        self.act_min       = CSRStorage(32, name="act_min",       reset=2**32 - 128, description="Limite inferior da ativação (int32).")
+        self.act_max       = CSRStorage(32, name="act_max",       reset=127,         description="Limite superior da ativação (int32).")
+
+        self.reset        = Signal()   # Descarta os resultados em voo (ex.: `clear` da FIFO)
+        self.sink_valid   = Signal()
+        self.sink_acc     = Signal(64)
+        self.source_valid = Signal()
+        self.source_data  = Signal(64)
+
+        # Latência de accelerator_requant quando habilitado
+        self.latency = 4
+
+        rq_valid = Signal()
+        rq_data  = Signal((32, True))
+
+        self.specials += Instance("accelerator_requant",
+            p_SINGLE_ROUNDING=int(single_rounding),
+            i_clk=ClockSignal(),
+            i_rst=ResetSignal() | self.reset,
+            i_in_valid=self.sink_valid,
+            i_in_acc=self.sink_acc[0:32],
+            i_bias=self.bias.storage,
+            i_multiplier=self.multiplier.storage,
+            i_shift=self.shift.storage,
+            i_output_offset=self.output_offset.storage,
+            i_act_min=self.act_min.storage,
+            i_act_max=self.act_max.storage,
+            o_out_valid=rq_valid,
+            o_out_data=rq_data,
+        )
+
+        self.comb += [
+            If(self.enable.storage,
+                self.source_valid.eq(rq_valid),
+                self.source_data.eq(rq_data),
+            ).Else(
+                self.source_valid.eq(self.sink_valid),
+                self.source_data.eq(self.sink_acc),
+            )
+        ]
+
+# DMA ----------------------------------------------------------------------------------------------
+
+class AcceleratorDMA(LiteXModule):
+    """Produto escalar com operandos lidos da memória via Wishbone.
+
+    O firmware programa os endereços de A, B e do resultado, o comprimento e os
+    passos; uma escrita em `start` dispara a busca dos pares (a, b), que são
+    acumulados por `accelerator_stream`. O resultado de 64 bits é escrito em
+    `result_base` (parte baixa primeiro) e `done` sobe em seguida. O custo no
+    firmware é constante, independente do comprimento do vetor.
+    """
+    def __init__(self, platform, with_int8=False, with_requant=False):
+        platform.add_source(os.path.join(RTL_DIR, "accelerator_stream.sv"))
+
+        self.int8    = int8    = AcceleratorInt8Config() if with_int8 else None
+        self.requant = requant = AcceleratorRequant(platform) if with_requant else None
+
+        self.bus = bus = wishbone.Interface(data_width=32)
+
+        self.a_base      = CSRStorage(32, name="a_base",      description="Endereço (bytes, alinhado a 4) do primeiro elemento de A.")
+        self.b_base      = CSRStorage(32, name="b_base",      description="Endereço (bytes, alinhado a 4) do primeiro elemento de B.")
+        self.a_stride    = CSRStorage(16, name="a_stride",    reset=1, description="Passo entre elementos de A, em palavras de 32 bits.")
+        self.b_stride    = CSRStorage(16, name="b_stride",    reset=1, description="Passo entre elementos de B, em palavras de 32 bits.")
+        self.length      = CSRStorage(16, name="length",      description="Número de elementos do produto escalar.")
+        self.result_base = CSRStorage(32, name="result_base", description="Endereço (bytes, alinhado a 8) onde o resultado de 64 bits é escrito.")
+        self.start_csr   = CSRStorage(1,  name="start",       description="Escrever 1 inicia a busca dos operandos.")
+        self.done_csr    = CSRStatus(1,   name="done",        description="Resultado escrito na memória.")
+
+        # Sinais Internos
+        a_addr     = Signal(30)
+        b_addr     = Signal(30)
+        count      = Signal(16)
+        a_data     = Signal(32)
+        result     = Signal(64)
+        done       = Signal()
+        in_valid   = Signal()
+        in_last    = Signal()
+        out_valid  = Signal()
+        out_result = Signal(64)
+
+        self.specials += Instance("accelerator_stream",
+            **_stream_int8_params(int8),
+            i_clk=ClockSignal(),
+            i_rst=ResetSignal(),
+            i_in_valid=in_valid,
+            i_in_last=in_last,
+            i_in_a=a_data,
+            i_in_b=bus.dat_r,
+            o_out_valid=out_valid,
+            o_out_result=out_result,
+        )
+
+        self.comb += [
+            bus.sel.eq(0b1111),
+            self.done_csr.status.eq(done),
+        ]
+
+        # Contadores de desempenho: ocupado fora de IDLE, parado enquanto espera o `ack`
+        self.busy  = Signal()
+        self.stall = Signal()
+        self.macs  = Signal(3)
+        self.comb += [
+            self.stall.eq(bus.cyc & bus.stb & ~bus.ack),
+            If(in_valid,
+                self.macs.eq(1 if int8 is None else Mux(int8.enable.storage, 4, 1))
+            ),
+        ]
+
+        # Com requantização, o resultado escrito na memória é a ativação final
+        if requant is not None:
+            core_valid  = out_valid
+            core_result = out_result
+            out_valid   = Signal()
+            out_result  = Signal(64)
+            self.comb += [
+                requant.sink_valid.eq(core_valid),
+                requant.sink_acc.eq(core_result),
+                out_valid.eq(requant.source_valid),
+                out_result.eq(requant.source_data),
+            ]
+
+        # Máquina de estados: lê A[i], lê B[i], entrega o par ao MAC; ao fim escreve o resultado
+        self.fsm = fsm = FSM(reset_state="IDLE")
+        fsm.act("IDLE",
+            If(self.start_csr.re & self.start_csr.storage,
+                NextValue(done, 0),
+                NextValue(a_addr, self.a_base.storage[2:]),
+                NextValue(b_addr, self.b_base.storage[2:]),
+                NextValue(count,  self.length.storage),
+                If(self.length.storage == 0,
+                    NextValue(result, 0),
+                    NextState("WRITE_LO")
+                ).Else(
+                    NextState("READ_A")
+                )
+            )
+        )
+        fsm.act("READ_A",
+            bus.cyc.eq(1),
+            bus.stb.eq(1),
+            bus.adr.eq(a_addr),
+            If(bus.ack,
+                NextValue(a_data, bus.dat_r),
+                NextState("READ_B")
+            )
+        )
+        fsm.act("READ_B",
+            bus.cyc.eq(1),
+            bus.stb.eq(1),
+            bus.adr.eq(b_addr),
+            If(bus.ack,
+                in_valid.eq(1),
+                in_last.eq(count == 1),
+                NextValue(a_addr, a_addr + self.a_stride.storage),
+                NextValue(b_addr, b_addr + self.b_stride.storage),
+                NextValue(count,  count - 1),
+                If(count == 1,
+                    NextState("WAIT")
+                ).Else(
+                    NextState("READ_A")
+                )
+            )
+        )
+        fsm.act("WAIT",
+            If(out_valid,
+                NextValue(result, out_result),
+                NextState("WRITE_LO")
+            )
+        )
+        fsm.act("WRITE_LO",
+            bus.cyc.eq(1),
+            bus.stb.eq(1),
+            bus.we.eq(1),
+            bus.adr.eq(self.result_base.storage[2:]),
+            bus.dat_w.eq(result[0:32]),
+            If(bus.ack,
+                NextState("WRITE_HI")
+            )
+        )
+        fsm.act("WRITE_HI",
+            bus.cyc.eq(1),
+            bus.stb.eq(1),
+            bus.we.eq(1),
+            bus.adr.eq(self.result_base.storage[2:] + 1),
+            bus.dat_w.eq(result[32:64]),
+            If(bus.ack,
+                NextValue(done, 1),
+                NextState("IDLE")
+            )
+        )
+        self.comb += self.busy.eq(~fsm.ongoing("IDLE"))
+
+# FIFO ---------------------------------------------------------------------------------------------
+
+class AcceleratorFIFO(LiteXModule):
+    """Fila de produtos escalares com FIFOs de operandos e de resultados.
+
+    Cada escrita em `a_data`/`b_data` empilha um elemento na FIFO de A/B. O MAC
+    (`accelerator_stream`) consome um par por ciclo sempre que as duas FIFOs têm
+    dados e fecha um resultado a cada `job_len` elementos, sem handshake de
+    start/done: vetores consecutivos se sobrepõem no pipeline. Os resultados de
+    64 bits ficam na FIFO de saída, lida por `result_lo`/`result_hi` e
+    descartada com uma escrita em `result_pop`.
+    """
+    def __init__(self, platform, depth=256, result_depth=64, with_int8=False, with_requant=False):
+        platform.add_source(os.path.join(RTL_DIR, "accelerator_stream.sv"))
+
+        self.int8    = int8    = AcceleratorInt8Config() if with_int8 else None
+        self.requant = requant = AcceleratorRequant(platform) if with_requant else None
+
+        self.depth = depth
+
+        self.a_data     = CSRStorage(32, name="a_data",     description="Escrita empilha um elemento de A.")
+        self.b_data     = CSRStorage(32, name="b_data",     description="Escrita empilha um elemento de B.")
+        self.job_len    = CSRStorage(16, name="job_len",    reset=8, description="Elementos por produto escalar (0 ou 1: um elemento).")
+        self.clear      = CSRStorage(1,  name="clear",      description="Escrever 1 esvazia as FIFOs e reinicia a contagem de elementos.")
+        self.a_space    = CSRStatus(16,  name="a_space",    description="Posições livres na FIFO de A.")
+        self.b_space    = CSRStatus(16,  name="b_space",    description="Posições livres na FIFO de B.")
+        self.results    = CSRStatus(16,  name="results",    description="Resultados disponíveis na FIFO de saída.")
+        self.result_hi  = CSRStatus(32,  name="result_hi",  description="Parte alta (bits 63-32) do resultado mais antigo.")
+        self.result_lo  = CSRStatus(32,  name="result_lo",  description="Parte baixa (bits 31-0) do resultado mais antigo.")
+        self.result_pop = CSRStorage(1,  name="result_pop", description="Escrever 1 descarta o resultado mais antigo.")
+
+        # FIFOs
+        clear = Signal()
+        self.a_fifo = a_fifo = ResetInserter()(stream.SyncFIFO([("data", 32)], depth, buffered=True))
+        self.b_fifo = b_fifo = ResetInserter()(stream.SyncFIFO([("data", 32)], depth, buffered=True))
+        self.r_fifo = r_fifo = ResetInserter()(stream.SyncFIFO([("data", 64)], result_depth, buffered=True))
+        self.comb += [
+            clear.eq(self.clear.re & self.clear.storage),
+            a_fifo.reset.eq(clear),
+            b_fifo.reset.eq(clear),
+            r_fifo.reset.eq(clear),
+        ]
+
+        # Sinais Internos
+        elem       = Signal(16)
+        fire       = Signal()
+        last       = Signal()
+        out_valid  = Signal()
+        out_result = Signal(64)
+
+        self.specials += Instance("accelerator_stream",
+            **_stream_int8_params(int8),
+            i_clk=ClockSignal(),
+            i_rst=ResetSignal() | clear,
+            i_in_valid=fire,
+            i_in_last=last,
+            i_in_a=a_fifo.source.data,
+            i_in_b=b_fifo.source.data,
+            o_out_valid=out_valid,
+            o_out_result=out_result,
+        )
+
+        # Com requantização (parâmetros por tensor), a FIFO guarda as ativações finais
+        in_flight = 2
+        if requant is not None:
+            core_valid  = out_valid
+            core_result = out_result
+            out_valid   = Signal()
+            out_result  = Signal(64)
+            self.comb += [
+                requant.reset.eq(clear),
+                requant.sink_valid.eq(core_valid),
+                requant.sink_acc.eq(core_result),
+                out_valid.eq(requant.source_valid),
+                out_result.eq(requant.source_data),
+            ]
+            in_flight += requant.latency
+
+        # Consome um par por ciclo enquanto houver espaço para os resultados em voo
+        # (a latência do MAC e da requantização) na FIFO de saída.
+        self.comb += [
+            fire.eq(a_fifo.source.valid & b_fifo.source.valid & (r_fifo.level < result_depth - in_flight)),
+            last.eq(elem + 1 >= self.job_len.storage),
+            a_fifo.source.ready.eq(fire),
+            b_fifo.source.ready.eq(fire),
+        ]
+        # Contadores de desempenho: parado quando há um job começado ou operandos
+        # na fila, mas o MAC não avança (falta o outro operando ou espaço na saída)
+        self.busy  = Signal()
+        self.stall = Signal()
+        self.job   = Signal()
+        self.macs  = Signal(3)
+        self.comb += [
+            self.busy.eq(fire),
+            self.stall.eq(((elem != 0) | a_fifo.source.valid | b_fifo.source.valid) & ~fire),
+            self.job.eq(out_valid),
+            If(fire,
+                self.macs.eq(1 if int8 is None else Mux(int8.enable.storage, 4, 1))
+            ),
+        ]
+
+        self.sync += [
+            If(clear,
+                elem.eq(0)
+            ).Elif(fire,
+                If(last,
+                    elem.eq(0)
+                ).Else(
+                    elem.eq(elem + 1)
+                )
+            )
+        ]
+
+        # Lógica Combinacional para Conectar CSRs às FIFOs
+        self.comb += [
+            If(self.a_data.re,
+                a_fifo.sink.valid.eq(1),
+                a_fifo.sink.data.eq(self.a_data.storage),
+            ),
+            If(self.b_data.re,
+                b_fifo.sink.valid.eq(1),
+                b_fifo.sink.data.eq(self.b_data.storage),
+            ),
+            r_fifo.sink.valid.eq(out_valid),
+            r_fifo.sink.data.eq(out_result),
+            r_fifo.source.ready.eq(self.result_pop.re & self.result_pop.storage),
+
+            self.a_space.status.eq(depth - a_fifo.level),
+            self.b_space.status.eq(depth - b_fifo.level),
+            self.results.status.eq(r_fifo.level),
+            self.result_lo.status.eq(r_fifo.source.data[0:32]),
+            self.result_hi.status.eq(r_fifo.source.data[32:64]),
+        ]
+
+# Matriz sistólica ---------------------------------------------------------------------------------
+
+class AcceleratorSystolic(LiteXModule):
+    """Bloco C = (A + a_offset) x (B + b_offset) de `rows` x `cols` em int8, acumulado em int32.
+
+    Cada elemento de A é reutilizado em `cols` produtos e cada elemento de B em
+    `rows`, o que o produto escalar não consegue (ex.: Conv2D como GEMM sobre o
+    im2col, com A = pixels e B = filtros). Os operandos ficam em buffers locais
+    de `depth` valores de k, escritos palavra a palavra: para cada k, ceil(rows/4)
+    palavras de A (linha 4w+r no byte r da palavra w) e ceil(cols/4) de B. Uma
+    escrita em `a_addr`/`b_addr` posiciona o ponteiro, que avança a cada escrita
+    em `a_data`/`b_data`. Um `start` calcula `k_len` valores de k; com
+    `accumulate` em 1 o resultado anterior é mantido (K maior que `depth`). O
+    resultado (i, j) é lido em `result` após escrever i*cols + j em `sel`.
+    """
+    def __init__(self, platform, rows=4, cols=4, depth=256):
+        platform.add_source(os.path.join(RTL_DIR, "accelerator_systolic.sv"))
+
+        self.rows  = rows
+        self.cols  = cols
+        self.depth = depth
+        a_words = (rows + 3)//4
+        b_words = (cols + 3)//4
+
+        self.a_addr     = CSRStorage(16, name="a_addr",     description="Palavra de A escrita pelo próximo `a_data` (k*ceil(rows/4) + w).")
+        self.a_data     = CSRStorage(32, name="a_data",     description="Escreve quatro int8 de A e avança `a_addr`.")
+        self.b_addr     = CSRStorage(16, name="b_addr",     description="Palavra de B escrita pelo próximo `b_data` (k*ceil(cols/4) + w).")
+        self.b_data     = CSRStorage(32, name="b_data",     description="Escreve quatro int8 de B e avança `b_addr`.")
+        self.k_len      = CSRStorage(16, name="k_len",      description=f"Valores de k por `start` (1..{depth}).")
+        self.a_offset   = CSRStorage(16, name="a_offset",   description="Somado a cada int8 de A (input_offset no TFLM).")
+        self.b_offset   = CSRStorage(16, name="b_offset",   description="Somado a cada int8 de B (weights_offset no TFLM).")
+        self.accumulate = CSRStorage(1,  name="accumulate", description="1: `start` soma ao resultado anterior.")
+        self.start_csr  = CSRStorage(1,  name="start",      description="Escrever 1 inicia o cálculo do bloco.")
+        self.done_csr   = CSRStatus(1,   name="done",       description="Bloco calculado (zerado por `start`).")
+        self.sel        = CSRStorage(16, name="sel",        description="Elemento lido em `result`: i*cols + j.")
+        self.result     = CSRStatus(32,  name="result",     description="Acumulador int32 do elemento selecionado.")
+
+        # Pulso de fim de bloco (fonte de interrupção no Accelerator) e sinais dos contadores
+        self.done_pulse = Signal()
+        self.busy       = Signal()
+        self.macs       = Signal(32)
+
+        # Sinais Internos
+        a_ptr = Signal(16)
+        b_ptr = Signal(16)
+        start = Signal()
+        done  = Signal()
+
+        self.specials += Instance("accelerator_systolic",
+            p_ROWS=rows,
+            p_COLS=cols,
+            p_DEPTH=depth,
+            i_clk=ClockSignal(),
+            i_rst=ResetSignal(),
+            i_a_we=self.a_data.re,
+            i_a_waddr=a_ptr[:log2_int(depth*a_words, need_pow2=False)],
+            i_a_wdata=self.a_data.storage,
+            i_b_we=self.b_data.re,
+            i_b_waddr=b_ptr[:log2_int(depth*b_words, need_pow2=False)],
+            i_b_wdata=self.b_data.storage,
+            i_start=start,
+            i_accumulate=self.accumulate.storage,
+            i_k_len=self.k_len.storage,
+            i_a_offset=self.a_offset.storage,
+            i_b_offset=self.b_offset.storage,
+            o_busy=self.busy,
+            o_done=self.done_pulse,
+            i_res_sel=self.sel.storage[:max(log2_int(rows*cols, need_pow2=False), 1)],
+            o_res_data=self.result.status,
+        )
+
+        self.comb += [
+            start.eq(self.start_csr.re & self.start_csr.storage),
+            self.done_csr.status.eq(done),
+            If(self.done_pulse,
+                self.macs.eq(rows*cols*self.k_len.storage)
+            ),
+        ]
+        self.sync += [
+            If(self.a_addr.re, a_ptr.eq(self.a_addr.storage)).Elif(self.a_data.re, a_ptr.eq(a_ptr + 1)),
+            If(self.b_addr.re, b_ptr.eq(self.b_addr.storage)).Elif(self.b_data.re, b_ptr.eq(b_ptr + 1)),
+            If(start, done.eq(0)).Elif(self.done_pulse, done.eq(1)),
+        ]
+
+# Driver em C --------------------------------------------------------------------------------------
+
+_DRIVER_H = """\
+/*
+ * Driver do acelerador de produto escalar.
+ * Gerado por accelerator/litex/accelerator.py (Accelerator.generate_driver): não editar.
+ *
+ * Os CSRs a0..aN-1 e b0..bN-1 ocupam uma janela contígua de 2N palavras de 32
+ * bits, acessada por ponteiro: carregar os operandos é um laço de stores, sem
+ * uma chamada de função por registrador.
+ */
+#ifndef __GENERATED_ACCEL_DRIVER_H
+#define __GENERATED_ACCEL_DRIVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <generated/csr.h>
+#include <generated/soc.h>
+
+#ifdef CSR_ACCELERATOR_A0_ADDR
+
+#if CONFIG_CSR_DATA_WIDTH != 32
+#error "accel_driver: a janela de operandos supõe CSRs de 32 bits"
+#endif
+
+#define ACCEL_VECTOR_LEN  $vector_len
+#define ACCEL_LANES       $lanes
+#define ACCEL_PIPELINED   $pipelined
+#define ACCEL_COUNT       $count
+#define ACCEL_STICKY      $sticky
+
+/* Campos de accelerator_sticky_status (modo sticky, ver AcceleratorSticky) */
+#define ACCEL_STICKY_DONE(status)  ((status) & 1)
+#define ACCEL_STICKY_TAG(status)   (((status) >> 8) & 0xff)
+$fifo_depth$fir_depth
+#define ACCEL_A_WINDOW  ((volatile uint32_t *)CSR_ACCELERATOR_A0_ADDR)
+#define ACCEL_B_WINDOW  ((volatile uint32_t *)CSR_ACCELERATOR_B0_ADDR)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Job disparado e ainda não concluído; interrupções tratadas por accel_isr() */
+extern volatile int accel_pending;
+extern volatile int accel_irq_count;
+
+/* Escreve a[0, n) nas primeiras posições de A (n <= ACCEL_VECTOR_LEN) */
+static inline void accel_load_a(const int32_t *a, size_t n)
+{
+    volatile uint32_t *w = ACCEL_A_WINDOW;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        w[i] = (uint32_t)a[i];
+}
+
+/* Escreve b[0, n) em B e zera o restante: os valores antigos de A não contribuem */
+static inline void accel_load_b(const int32_t *b, size_t n)
+{
+    volatile uint32_t *w = ACCEL_B_WINDOW;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        w[i] = (uint32_t)b[i];
+    for (; i < ACCEL_VECTOR_LEN; i++)
+        w[i] = 0;
+}
+
+/* Habilita a interrupção de fim de cálculo, se o SoC tiver a linha de IRQ */
+void accel_init(void);
+
+/*
+ * API não bloqueante: accel_start() dispara um job sobre os operandos já na
+ * janela (accel_submit() escreve os ACCEL_VECTOR_LEN elementos de a e b antes);
+ * accel_poll() retorna 1 e o resultado quando o job terminou. Com accel_init()
+ * e interrupção, a conclusão é tratada em accel_isr(); sem ela, lê `done`.
+ * Com ACCEL_STICKY o primeiro accel_start() liga o modo sticky: o fim do job é
+ * uma única leitura de `sticky_status` e não há escrita de 0 em `start`.
+ */
+void accel_start(void);
+void accel_submit(const int32_t *a, const int32_t *b);
+int accel_poll(int64_t *result);
+int64_t accel_wait(void);
+
+/* Produto escalar de n elementos, em blocos de ACCEL_VECTOR_LEN */
+int64_t accel_dot(const int32_t *a, const int32_t *b, size_t n);
+
+/*
+ * count produtos escalares de n elementos: results[j] = a[j*n...] . b[j*b_stride...].
+ * Com b_stride = 0 todos usam o mesmo b (ex.: linhas de pesos contra uma
+ * entrada), que é escrito uma única vez por instância quando cabe na janela.
+ * Com várias instâncias os jobs são distribuídos entre elas (accel_dispatch);
+ * senão, se o SoC tiver a FIFO de jobs, os vetores são encadeados nela.
+ */
+void accel_dot_many(const int32_t *a, const int32_t *b, size_t n, size_t count,
+                    size_t b_stride, int64_t *results);
+
+/*
+ * Dispatcher em round-robin sobre as `instances` primeiras instâncias (0 ou
+ * mais que ACCEL_COUNT: todas): cada uma recebe um job inteiro e, assim que
+ * termina um bloco, já recebe o próximo, enquanto as outras calculam.
+ */
+void accel_dispatch(const int32_t *a, const int32_t *b, size_t n, size_t count,
+                    size_t b_stride, int64_t *results, int instances);
+
+#ifdef ACCEL_FIFO_DEPTH
+/*
+ * Mesmos argumentos de accel_dot_many(), sempre pela FIFO de jobs da
+ * instância 0 (n <= ACCEL_FIFO_DEPTH): os vetores são enfileirados sem
+ * esperar pelos resultados, recolhidos sempre que a FIFO de entrada enche.
+ */
+void accel_fifo_dot_many(const int32_t *a, const int32_t *b, size_t n, size_t count,
+                         size_t b_stride, int64_t *results);
+#endif
+
+#ifdef ACCEL_FIR_DEPTH
+/*
+ * Modo FIR: y[k] = sum_j coeffs[j] * x[k-j], arredondado para
+ * (acumulador + 2^(shift-1)) >> shift. accel_fir_init() carrega os `taps`
+ * coeficientes (taps <= ACCEL_VECTOR_LEN) em A, zera a linha de atraso e liga
+ * o modo; chamadas seguidas de accel_fir() continuam o mesmo sinal. O produto
+ * escalar (accel_dot etc.) só volta a funcionar depois de accel_fir_end().
+ */
+void accel_fir_init(const int32_t *coeffs, size_t taps, int shift);
+void accel_fir(const int32_t *x, int64_t *y, size_t n);
+void accel_fir_end(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSR_ACCELERATOR_A0_ADDR */
+
+#endif /* __GENERATED_ACCEL_DRIVER_H */
+"""
+
+_DRIVER_C = """\
+/*
+ * Driver do acelerador de produto escalar (ver accel_driver.h).
+ * Gerado por accelerator/litex/accelerator.py (Accelerator.generate_driver): não editar.
+ */
+#include <generated/accel_driver.h>
+
+#ifdef CSR_ACCELERATOR_A0_ADDR
+
+#ifdef ACCELERATOR_INTERRUPT
+#include <irq.h>
+#include <isr.h>
+#endif
+
+volatile int accel_pending;
+volatile int accel_irq_count;
+
+static int accel_irq_enabled;
+
+#if ACCEL_STICKY
+static int accel_sticky_on;
+static uint8_t accel_tag;           /* Tag do último job disparado */
+
+static void accel_sticky_init(void)
+{
+    accelerator_sticky_enable_write(1);
+    accel_tag = ACCEL_STICKY_TAG(accelerator_sticky_status_read());
+    accel_sticky_on = 1;
+}
+
+/* Resultado do job `tag` no buffer duplo (válido até o job tag + 2 terminar) */
+static int64_t accel_sticky_result(uint8_t tag)
+{
+    return (int64_t)(tag & 1 ? accelerator_sticky_result1_read() : accelerator_sticky_result0_read());
+}
+#endif
+
+#ifdef ACCELERATOR_INTERRUPT
+static void accel_isr(void)
+{
+    accelerator_ev_pending_write(accelerator_ev_pending_read());
+    accelerator_start_write(0);
+    accel_pending = 0;
+    accel_irq_count++;
+}
+#endif
+
+void accel_init(void)
+{
+#ifdef ACCELERATOR_INTERRUPT
+    accelerator_ev_pending_write(accelerator_ev_pending_read());
+    accelerator_ev_enable_write(1 << CSR_ACCELERATOR_EV_ENABLE_DONE_OFFSET);
+    irq_attach(ACCELERATOR_INTERRUPT, accel_isr);
+    irq_setmask(irq_getmask() | (1 << ACCELERATOR_INTERRUPT));
+    accel_irq_enabled = 1;
+#endif
+}
+
+void accel_start(void)
+{
+#if ACCEL_STICKY
+    if (!accel_sticky_on)
+        accel_sticky_init();
+    accel_tag++;
+#endif
+    accel_pending = 1;
+    accelerator_start_write(1);
+}
+
+/* Atualiza accel_pending; retorna 1 quando o último job disparado terminou */
+static int accel_done(void)
+{
+    if (accel_pending && !accel_irq_enabled) {
+#if ACCEL_STICKY
+        if (ACCEL_STICKY_TAG(accelerator_sticky_status_read()) == accel_tag)
+            accel_pending = 0;
+#else
+        if (accelerator_done_read()) {
+            accelerator_start_write(0);
+            accel_pending = 0;
+        }
+#endif
+    }
+    return !accel_pending;
+}
+
+void accel_submit(const int32_t *a, const int32_t *b)
+{
+    accel_load_a(a, ACCEL_VECTOR_LEN);
+    accel_load_b(b, ACCEL_VECTOR_LEN);
+    accel_start();
+}
+
+int accel_poll(int64_t *result)
+{
+#if ACCEL_STICKY
+    if (!accel_done())
+        return 0;
+    *result = accel_sticky_result(accel_tag);
+#else
+    int64_t result_hi;
+    uint32_t result_lo;
+
+    if (!accel_done())
+        return 0;
+    result_lo = accelerator_result_lo_read();
+    result_hi = (int32_t)accelerator_result_hi_read();
+    *result = (int64_t)((uint64_t)result_hi << 32 | result_lo);
+#endif
+    return 1;
+}
+
+int64_t accel_wait(void)
+{
+    int64_t result;
+
+    while (!accel_poll(&result));
+    return result;
+}
+
+int64_t accel_dot(const int32_t *a, const int32_t *b, size_t n)
+{
+    uint64_t sum = 0;
+    size_t i, len;
+#if ACCEL_STICKY
+    uint8_t prev;
+
+    /* O resultado de cada bloco é lido do buffer duplo enquanto o próximo calcula */
+    for (i = 0; i < n; i += len) {
+        len = n - i < ACCEL_VECTOR_LEN ? n - i : ACCEL_VECTOR_LEN;
+        while (!accel_done());
+        accel_load_a(a + i, len);
+        accel_load_b(b + i, len);
+        prev = accel_tag;
+        accel_start();
+        if (i > 0)
+            sum += (uint64_t)accel_sticky_result(prev);
+    }
+    if (n > 0)
+        sum += (uint64_t)accel_wait();
+#else
+    for (i = 0; i < n; i += len) {
+        len = n - i < ACCEL_VECTOR_LEN ? n - i : ACCEL_VECTOR_LEN;
+        accel_load_a(a + i, len);
+        accel_load_b(b + i, len);
+        accel_start();
+        sum += (uint64_t)accel_wait();
+    }
+#endif
+    return (int64_t)sum;
+}
+
+/* Registradores de cada instância do núcleo */
+typedef struct {
+    uintptr_t a, b, start, done, result_lo, result_hi;
+} accel_regs_t;
+
+static const accel_regs_t accel_regs[ACCEL_COUNT] = {
+$regs};
+
+/* Job em andamento em uma instância do dispatcher */
+typedef struct {
+    size_t job, off;
+    uint64_t sum;
+    const int32_t *b;           /* Bloco de B que está na janela da instância */
+    size_t b_len;
+    int busy;
+} accel_slot_t;
+
+static void accel_inst_load(int i, accel_slot_t *s, const int32_t *a, const int32_t *b, size_t len)
+{
+    volatile uint32_t *wa = (volatile uint32_t *)accel_regs[i].a;
+    volatile uint32_t *wb = (volatile uint32_t *)accel_regs[i].b;
+    size_t k;
+
+    for (k = 0; k < len; k++)
+        wa[k] = (uint32_t)a[k];
+    if (b != s->b || len != s->b_len) {
+        for (k = 0; k < len; k++)
+            wb[k] = (uint32_t)b[k];
+        for (; k < ACCEL_VECTOR_LEN; k++)
+            wb[k] = 0;
+        s->b     = b;
+        s->b_len = len;
+    }
+}
+
+/* A instância 0 passa por accel_start()/accel_poll(), que respeitam a interrupção */
+static void accel_inst_start(int i)
+{
+    if (i == 0)
+        accel_start();
+    else
+        csr_write_simple(1, accel_regs[i].start);
+}
+
+static int accel_inst_poll(int i, int64_t *result)
+{
+    uint64_t result_hi;
+    uint32_t result_lo;
+
+    if (i == 0)
+        return accel_poll(result);
+    if (!csr_read_simple(accel_regs[i].done))
+        return 0;
+    csr_write_simple(0, accel_regs[i].start);
+    result_lo = csr_read_simple(accel_regs[i].result_lo);
+    result_hi = csr_read_simple(accel_regs[i].result_hi);
+    *result = (int64_t)(result_hi << 32 | result_lo);
+    return 1;
+}
+
+void accel_dispatch(const int32_t *a, const int32_t *b, size_t n, size_t count,
+                    size_t b_stride, int64_t *results, int instances)
+{
+    accel_slot_t slot[ACCEL_COUNT];
+    size_t next = 0, finished = 0, len;
+    int64_t partial;
+    int i;
+
+    if (instances < 1 || instances > ACCEL_COUNT)
+        instances = ACCEL_COUNT;
+    for (i = 0; i < instances; i++) {
+        slot[i].busy  = 0;
+        slot[i].b     = NULL;
+        slot[i].b_len = 0;
+    }
+    if (n == 0) {
+        for (next = 0; next < count; next++)
+            results[next] = 0;
+        return;
+    }
+
+    while (finished < count) {
+        for (i = 0; i < instances; i++) {
+            accel_slot_t *s = &slot[i];
+
+            if (s->busy) {
+                if (!accel_inst_poll(i, &partial))
+                    continue;
+                s->sum += (uint64_t)partial;
+                s->off += ACCEL_VECTOR_LEN;
+                if (s->off >= n) {
+                    results[s->job] = (int64_t)s->sum;
+                    s->busy = 0;
+                    finished++;
+                }
+            }
+            if (!s->busy) {
+                if (next == count)
+                    continue;
+                s->job  = next++;
+                s->off  = 0;
+                s->sum  = 0;
+                s->busy = 1;
+            }
+            len = n - s->off < ACCEL_VECTOR_LEN ? n - s->off : ACCEL_VECTOR_LEN;
+            accel_inst_load(i, s, a + s->job*n + s->off, b + s->job*b_stride + s->off, len);
+            accel_inst_start(i);
+        }
+    }
+}
+
+#ifdef ACCEL_FIFO_DEPTH
+/* Lê os resultados disponíveis na FIFO de saída */
+static size_t accel_fifo_drain(int64_t *results, size_t got, size_t count)
+{
+    while (got < count && accelerator_fifo_results_read()) {
+        uint32_t lo = accelerator_fifo_result_lo_read();
+        uint64_t hi = accelerator_fifo_result_hi_read();
+        accelerator_fifo_result_pop_write(1);
+        results[got++] = (int64_t)(hi << 32 | lo);
+    }
+    return got;
+}
+
+void accel_fifo_dot_many(const int32_t *a, const int32_t *b, size_t n, size_t count,
+                         size_t b_stride, int64_t *results)
+{
+    volatile uint32_t *fifo_a = (volatile uint32_t *)CSR_ACCELERATOR_FIFO_A_DATA_ADDR;
+    volatile uint32_t *fifo_b = (volatile uint32_t *)CSR_ACCELERATOR_FIFO_B_DATA_ADDR;
+    size_t i, j, got = 0;
+
+    accelerator_fifo_clear_write(1);
+$fifo_modes    accelerator_fifo_job_len_write(n);
+    for (j = 0; j < count; j++, a += n, b += b_stride) {
+        while (accelerator_fifo_a_space_read() < n || accelerator_fifo_b_space_read() < n)
+            got = accel_fifo_drain(results, got, count);
+        for (i = 0; i < n; i++)
+            *fifo_a = (uint32_t)a[i];
+        for (i = 0; i < n; i++)
+            *fifo_b = (uint32_t)b[i];
+    }
+    while (got < count)
+        got = accel_fifo_drain(results, got, count);
+}
+#endif
+
+#ifdef ACCEL_FIR_DEPTH
+void accel_fir_init(const int32_t *coeffs, size_t taps, int shift)
+{
+    volatile uint32_t *w = ACCEL_A_WINDOW;
+    size_t i;
+
+    accelerator_fir_enable_write(0);
+    for (i = 0; i < taps; i++)
+        w[i] = (uint32_t)coeffs[i];
+    for (; i < ACCEL_VECTOR_LEN; i++)
+        w[i] = 0;
+    accelerator_fir_clear_write(1);
+    accelerator_fir_shift_write(shift);
+    accelerator_fir_enable_write(1);
+}
+
+/* Lê as saídas disponíveis na FIFO do FIR */
+static size_t accel_fir_drain(int64_t *y, size_t got, size_t n)
+{
+    while (got < n && accelerator_fir_outputs_read()) {
+        uint32_t lo = accelerator_fir_output_lo_read();
+        uint64_t hi = accelerator_fir_output_hi_read();
+        accelerator_fir_output_pop_write(1);
+        y[got++] = (int64_t)(hi << 32 | lo);
+    }
+    return got;
+}
+
+void accel_fir(const int32_t *x, int64_t *y, size_t n)
+{
+    volatile uint32_t *sample = (volatile uint32_t *)CSR_ACCELERATOR_FIR_SAMPLE_ADDR;
+    size_t i, got = 0;
+
+    for (i = 0; i < n; i++) {
+        while (!accelerator_fir_space_read())
+            got = accel_fir_drain(y, got, n);
+        *sample = (uint32_t)x[i];
+    }
+    while (got < n)
+        got = accel_fir_drain(y, got, n);
+}
+
+void accel_fir_end(void)
+{
+    accelerator_fir_enable_write(0);
+}
+#endif
+
+void accel_dot_many(const int32_t *a, const int32_t *b, size_t n, size_t count,
+                    size_t b_stride, int64_t *results)
+{
+#ifdef ACCEL_FIFO_DEPTH
+    if (ACCEL_COUNT == 1 && n > 0 && n <= ACCEL_FIFO_DEPTH && count > 1) {
+        accel_fifo_dot_many(a, b, n, count, b_stride, results);
+        return;
+    }
+#endif
+    accel_dispatch(a, b, n, count, b_stride, results, ACCEL_COUNT);
+}
+
+#endif /* CSR_ACCELERATOR_A0_ADDR */
+"""
@@ -27,14 +27,17 @@ from litedram.phy import GENSDRPHY, HalfRateGENSDRPHY
 
 from liteeth.phy.ecp5rgmii import LiteEthPHYRGMII
 
-from accelerator import Accelerator
+from accelerator import Accelerator, accel_csr_paging
 
 # CRG ----------------------------------------------------------------------------------------------
 
 class _CRG(LiteXModule):
-    def __init__(self, platform, sys_clk_freq, use_internal_osc=False, with_usb_pll=False, with_video_pll=False, sdram_rate="1:1"):
+    def __init__(self, platform, sys_clk_freq, use_internal_osc=False, with_usb_pll=False, with_video_pll=False, sdram_rate="1:1",
+        accel_clk_freq=None):
         self.rst    = Signal()
         self.cd_sys = ClockDomain()
+        if accel_clk_freq is not None:
+            self.cd_accel = ClockDomain()
         if sdram_rate == "1:2":
             self.cd_sys2x    = ClockDomain()
             self.cd_sys2x_ps = ClockDomain()
@@ -68,6 +71,9 @@ class _CRG(LiteXModule):
             pll.create_clkout(self.cd_sys2x_ps, 2*sys_clk_freq, phase=180) # Idealy 90° but needs to be increased.
         else:
            pll.create_clkout(self.cd_sys_ps, sys_clk_freq, phase=180) # Idealy 90° but needs to be increased.
+        # Clock próprio do núcleo do acelerador (--accel-clk-freq), independente do da CPU
+        if accel_clk_freq is not None:
+            pll.create_clkout(self.cd_accel, accel_clk_freq)
 
         # USB PLL
         if with_usb_pll:
@@ -107,6 +113,20 @@ class BaseSoC(SoCCore):
         sdram_rate             = "1:1",
         with_video_terminal    = False,
         with_video_framebuffer = False,
+        accel_pipelined        = False,
+        accel_vector_len       = 8,
+        accel_lanes            = None,
+        accel_dma              = False,
+        accel_fifo             = False,
+        accel_int8             = False,
+        accel_requant          = False,
+        accel_systolic         = False,
+        accel_systolic_rows    = 4,
+        accel_systolic_cols    = 4,
+        accel_count            = 1,
+        accel_sticky           = False,
+        accel_fir              = False,
+        accel_clk_freq         = None,
         **kwargs):
         board = board.lower()
         assert board in ["i5", "i9"]
@@ -119,10 +139,41 @@ class BaseSoC(SoCCore):
             use_internal_osc = use_internal_osc,
             with_usb_pll     = with_usb_pll,
             with_video_pll   = with_video_pll,
-            sdram_rate       = sdram_rate
+            sdram_rate       = sdram_rate,
+            accel_clk_freq   = accel_clk_freq
         )
 
+        # Accelerator ------------------------------------------------------------------------------
+        # Construído antes do SoCCore: a página de CSR depende dos CSRs que ele gera (ver
+        # accel_csr_paging). Com --accel-clk-freq o núcleo roda no domínio `accel` e só o
+        # handshake start/done é sincronizado (ver AcceleratorCDC); os operandos são estáveis
+        # durante o cálculo.
+        accel_cd = "sys" if accel_clk_freq is None else "accel"
+        accelerator = Accelerator(platform,
+            vector_len    = accel_vector_len,
+            lanes         = accel_lanes,
+            pipelined     = accel_pipelined,
+            with_dma      = accel_dma,
+            with_fifo     = accel_fifo,
+            with_int8     = accel_int8,
+            with_requant  = accel_requant,
+            with_systolic = accel_systolic,
+            systolic_rows = accel_systolic_rows,
+            systolic_cols = accel_systolic_cols,
+            with_sticky   = accel_sticky,
+            with_fir      = accel_fir,
+            clock_domain  = accel_cd)
+
+        # Instâncias extras (--accel-count): só o núcleo de produto escalar, cada uma com a
+        # própria região de CSRs (accelerator1, accelerator2...), usadas pelo dispatcher do driver.
+        accel_extra = [Accelerator(platform,
+            vector_len   = accel_vector_len,
+            lanes        = accel_lanes,
+            pipelined    = accel_pipelined,
+            clock_domain = accel_cd) for _ in range(1, accel_count)]
+
         # SoCCore ----------------------------------------------------------------------------------
+        kwargs["csr_paging"] = accel_csr_paging([accelerator] + accel_extra, kwargs.get("csr_paging", 0x800))
         SoCCore.__init__(self, platform, int(sys_clk_freq), ident = "LiteX SoC on Colorlight " + board.upper(), **kwargs)
         
         # Leds -------------------------------------------------------------------------------------
@@ -130,8 +181,29 @@ class BaseSoC(SoCCore):
             ledn = platform.request_all("user_led_n")
             self.leds = LedChaser(pads=ledn, sys_clk_freq=sys_clk_freq)
 
-        self.submodules.accelerator = Accelerator(self.platform)
+        if accel_clk_freq is not None:
+            self.platform.add_false_path_constraints(self.crg.cd_sys.clk, self.crg.cd_accel.clk)
+            self.add_constant("ACCELERATOR_CLK_FREQ", int(accel_clk_freq))
+
+        self.submodules.accelerator = accelerator
         self.add_csr("accelerator")
+        if self.irq.enabled:
+            self.irq.add("accelerator", use_loc_if_exists=True)
+        if accel_dma:
+            self.bus.add_master(name="accelerator_dma", master=self.accelerator.dma.bus)
+        self.add_constant("ACCELERATOR_VECTOR_LEN", accel_vector_len)
+        if accel_systolic:
+            self.add_constant("ACCELERATOR_SYSTOLIC_ROWS",  self.accelerator.systolic.rows)
+            self.add_constant("ACCELERATOR_SYSTOLIC_COLS",  self.accelerator.systolic.cols)
+            self.add_constant("ACCELERATOR_SYSTOLIC_DEPTH", self.accelerator.systolic.depth)
+
+        self.accel_extra = []
+        for i, extra in enumerate(accel_extra, start=1):
+            name = f"accelerator{i}"
+            setattr(self.submodules, name, extra)
+            self.add_csr(name)
+            self.accel_extra.append(name)
+        self.add_constant("ACCELERATOR_COUNT", accel_count)
 
         # SPI Flash --------------------------------------------------------------------------------
         if board == "i5":
@@ -207,6 +279,20 @@ def main():
     viopts = parser.target_group.add_mutually_exclusive_group()
     viopts.add_argument("--with-video-terminal",    action="store_true", help="Enable Video Terminal (HDMI).")
     viopts.add_argument("--with-video-framebuffer", action="store_true", help="Enable Video Framebuffer (HDMI).")
+    parser.add_target_argument("--accel-pipelined",  action="store_true", help="Use the pipelined (one vector per cycle) accelerator datapath.")
+    parser.add_target_argument("--accel-vector-len", default=8, type=int, help="Accelerator vector length (elements per dot product).")
+    parser.add_target_argument("--accel-lanes",      default=None, type=int, help="Accelerator parallel multipliers (must divide vector length).")
+    parser.add_target_argument("--accel-dma",        action="store_true", help="Add a Wishbone bus-master front-end that reads accelerator operands from memory.")
+    parser.add_target_argument("--accel-fifo",       action="store_true", help="Add operand/result FIFOs for batched accelerator jobs.")
+    parser.add_target_argument("--accel-int8",       action="store_true", help="Add INT8 packed mode (4 MACs per word) to the DMA/FIFO front-ends.")
+    parser.add_target_argument("--accel-requant",    action="store_true", help="Add the hardware bias/requantization/clamp output stage.")
+    parser.add_target_argument("--accel-systolic",      action="store_true", help="Add the int8 systolic-array matrix-multiply engine.")
+    parser.add_target_argument("--accel-systolic-rows", default=4, type=int, help="Systolic array rows (output pixels per tile).")
+    parser.add_target_argument("--accel-systolic-cols", default=4, type=int, help="Systolic array columns (output channels per tile).")
+    parser.add_target_argument("--accel-count",         default=1, type=int, help="Number of dot-product accelerator instances.")
+    parser.add_target_argument("--accel-sticky",        action="store_true", help="Add the sticky-result mode (self-clearing start, double-buffered result).")
+    parser.add_target_argument("--accel-clk-freq",      default=None, type=float, help="Run the accelerator core in its own clock domain at this frequency.")
+    parser.add_target_argument("--accel-fir",           action="store_true", help="Add the fixed-point FIR mode (coefficients in A, hardware delay line).")
     args = parser.parse_args()
 
     soc = BaseSoC(board=args.board, revision=args.revision,
@@ -221,6 +307,20 @@ def main():
         sdram_rate             = args.sdram_rate,
         with_video_terminal    = args.with_video_terminal,
         with_video_framebuffer = args.with_video_framebuffer,
+        accel_pipelined        = args.accel_pipelined,
+        accel_vector_len       = args.accel_vector_len,
+        accel_lanes            = args.accel_lanes,
+        accel_dma              = args.accel_dma,
+        accel_fifo             = args.accel_fifo,
+        accel_int8             = args.accel_int8,
+        accel_requant          = args.accel_requant,
+        accel_systolic         = args.accel_systolic,
+        accel_systolic_rows    = args.accel_systolic_rows,
+        accel_systolic_cols    = args.accel_systolic_cols,
+        accel_count            = args.accel_count,
+        accel_sticky           = args.accel_sticky,
+        accel_fir              = args.accel_fir,
+        accel_clk_freq         = args.accel_clk_freq,
         **parser.soc_argdict
     )
     soc.platform.add_extension(colorlight_i5._sdcard_pmod_io)
@@ -230,6 +330,7 @@ def main():
         soc.add_sdcard()
 
     builder = Builder(soc, **parser.builder_argdict)
+    soc.accelerator.generate_driver(builder.generated_dir, extra_instances=soc.accel_extra)
     if args.build:
         builder.build(**parser.toolchain_argdict)
 
@@ -1,112 +1,207 @@
-module accelerator (
+module accelerator #(
+    parameter int VECTOR_LEN = 8,           // Número de elementos de cada vetor
+    parameter int LANES      = 1,           // Multiplicadores em paralelo (deve dividir VECTOR_LEN)
+    // 0: FSM sequencial (LANES produtos por ciclo, VECTOR_LEN/LANES ciclos por vetor)
+    // 1: árvore de multiplicadores em pipeline (uma fatia de LANES elementos por ciclo)
+    parameter bit PIPELINED  = 1'b0
+) (
     input logic clk, rst,
-    input logic signed [31:0] a0,
-    input logic signed [31:0] a1,
-    input logic signed [31:0] a2,
-    input logic signed [31:0] a3,
-    input logic signed [31:0] a4,
-    input logic signed [31:0] a5,
-    input logic signed [31:0] a6,
-    input logic signed [31:0] a7,
-
-    input logic signed [31:0] b0,
-    input logic signed [31:0] b1,
-    input logic signed [31:0] b2,
-    input logic signed [31:0] b3,
-    input logic signed [31:0] b4,
-    input logic signed [31:0] b5,
-    input logic signed [31:0] b6,
-    input logic signed [31:0] b7,
+    input logic [VECTOR_LEN*32-1:0] a,      // Elemento i em a[32*i +: 32] (complemento de 2)
+    input logic [VECTOR_LEN*32-1:0] b,      // Elemento i em b[32*i +: 32] (complemento de 2)
     input logic start,
 
+    output logic ready,                     // Pode aceitar `start` neste ciclo
     output logic done,
     output logic signed [63:0] result
 );
 
+    localparam int BEATS  = VECTOR_LEN / LANES;    // Fatias de LANES elementos por vetor
+    localparam int LEVELS = $clog2(LANES);         // Níveis da árvore de somas
+    localparam int BW     = (BEATS > 1) ? $clog2(BEATS) : 1;
+
+    // Latência fixa do modo em pipeline (ciclos entre o `start` aceito e `done`):
+    // BEATS-1 ciclos emitindo as demais fatias, 1 de multiplicação, 1 por nível
+    // da árvore de somas e, quando há mais de uma fatia, 1 de acumulação.
+    localparam int LATENCY = BEATS + LEVELS + ((BEATS > 1) ? 1 : 0);
+
+    initial begin
+        if (VECTOR_LEN % LANES != 0)
+            $error("accelerator: LANES (%0d) deve dividir VECTOR_LEN (%0d)", LANES, VECTOR_LEN);
+    end
+
     // Variáveis internas
-    // logic signed [63:0] temp;                 // Acumulador temporário
-    logic signed [31:0] A_v [7:0];               // Vetor A interno
-    logic signed [31:0] B_v [7:0];               // Vetor B interno
-
-    assign A_v[0] = a0; assign B_v[0] = b0;
-    assign A_v[1] = a1; assign B_v[1] = b1;
-    assign A_v[2] = a2; assign B_v[2] = b2;
-    assign A_v[3] = a3; assign B_v[3] = b3;
-    assign A_v[4] = a4; assign B_v[4] = b4;
-    assign A_v[5] = a5; assign B_v[5] = b5;
-    assign A_v[6] = a6; assign B_v[6] = b6;
-    assign A_v[7] = a7; assign B_v[7] = b7;
-
-    logic [7:0]  index, index_next;                 // Index para o vetor;
-    logic signed [63:0] acc, acc_next;              // Acumulador da soma
-    logic signed [63:0] prod;                       // Produto de cada par
-
-    logic done_reg, done_next;                      // Registrador para guardar sinal de done
-
-    // Sinais para a máquina de estado
-    typedef enum logic [1:0] {
-        IDLE, 
-        CALC, 
-        DONE
-    } state_type;
-    state_type state, state_next;
-
-    always_ff @(posedge clk, posedge rst) begin
-        if (rst) begin
-            state <= IDLE;
-            index <= 0;
-            acc   <= 0;
-            done_reg <= 0;
-        end else begin
-            state <= state_next;
-            index <= index_next;
-            acc   <= acc_next;
-            done_reg <= done_next;
-        end
+    logic signed [31:0] A_v [VECTOR_LEN-1:0];      // Vetor A interno
+    logic signed [31:0] B_v [VECTOR_LEN-1:0];      // Vetor B interno
+
+    for (genvar i = 0; i < VECTOR_LEN; i++) begin : g_unpack
+        assign A_v[i] = a[32*i +: 32];
+        assign B_v[i] = b[32*i +: 32];
     end
 
+    generate
+    if (PIPELINED) begin : g_pipe
+        // -----------------------------------------------------------------
+        // Modo em pipeline: `start` funciona como strobe de entrada válida.
+        // Um `start` com `ready` alto aceita um par de vetores, que entra no
+        // pipeline como BEATS fatias consecutivas de LANES elementos; os
+        // operandos devem ficar estáveis enquanto `ready` estiver baixo.
+        // `done` pulsa por um ciclo LATENCY ciclos depois do `start`, com
+        // `result` válido nesse ciclo e mantido até o próximo resultado.
+        // -----------------------------------------------------------------
+        localparam int NP = 1 << LEVELS;           // LANES arredondado p/ potência de 2
+
+        logic [BW-1:0] beat;                        // Próxima fatia a emitir (0 = livre)
+        logic          issue;                       // Fatia emitida neste ciclo
+        logic [BW-1:0] issue_beat;
+        logic          issue_first, issue_last;
+
+        assign ready       = (beat == 0);
+        assign issue       = start || (beat != 0);
+        assign issue_beat  = beat;
+        assign issue_first = (beat == 0);
+        assign issue_last  = (beat == BW'(BEATS - 1));
+
+        always_ff @(posedge clk, posedge rst) begin
+            if (rst)
+                beat <= '0;
+            else if (issue && BEATS > 1)
+                beat <= issue_last ? '0 : beat + 1'b1;
+        end
+
+        logic signed [63:0] tree [LEVELS:0][NP-1:0]; // tree[0]: produtos; tree[LEVELS][0]: soma
+        logic [LEVELS:0] valid;                       // Bit de validade de cada estágio
+        logic [LEVELS:0] first, last;                 // Marcadores de primeira/última fatia
 
+        always_ff @(posedge clk, posedge rst) begin
+            if (rst)
+                valid <= '0;
+            else
+                valid <= (valid << 1) | (LEVELS+1)'(issue);
+        end
 
-    assign prod = A_v[index] * B_v[index];
+        always_ff @(posedge clk) begin
+            first <= (first << 1) | (LEVELS+1)'(issue_first);
+            last  <= (last << 1)  | (LEVELS+1)'(issue_last);
 
-    always_comb begin
-        state_next = state;
-        index_next = index;
-        acc_next   = acc;
-        done_next  = done_reg;
+            // Estágio 0: LANES multiplicadores em paralelo sobre a fatia atual
+            if (issue) begin
+                for (int i = LANES; i < NP; i++)
+                    tree[0][i] <= 64'sd0;
+                for (int i = 0; i < LANES; i++)
+                    tree[0][i] <= A_v[int'(issue_beat)*LANES + i] * B_v[int'(issue_beat)*LANES + i];
+            end
 
-        case (state) 
-            IDLE: begin
-                done_next  = 0;
-                if (start) begin
-                    state_next = CALC;
-                    index_next = 0;
-                    acc_next   = 0;  
+            // Estágios 1..LEVELS: árvore de somadores binária
+            for (int l = 0; l < LEVELS; l++) begin
+                if (valid[l]) begin
+                    for (int i = 0; i < (NP >> (l + 1)); i++)
+                        tree[l+1][i] <= tree[l][2*i] + tree[l][2*i+1];
                 end
             end
+        end
 
-            CALC: begin
-                acc_next   = acc + prod;
-                index_next = index + 1'b1;
-
-                if (index == 4'd7) begin
-                    state_next = DONE;
-                    done_next = 1;
-                end
+        if (BEATS == 1) begin : g_single
+            assign done   = valid[LEVELS];
+            assign result = tree[LEVELS][0];
+        end else begin : g_accum
+            // Estágio de acumulação das somas parciais de cada fatia
+            logic signed [63:0] acc;
+            logic               acc_valid;
+
+            always_ff @(posedge clk, posedge rst) begin
+                if (rst)
+                    acc_valid <= 1'b0;
+                else
+                    acc_valid <= valid[LEVELS] && last[LEVELS];
             end
 
-            DONE: begin
-                if (!start)      
-                    state_next = IDLE;      // Retorna ao IDLE apenas se start for desativado
+            always_ff @(posedge clk) begin
+                if (valid[LEVELS])
+                    acc <= (first[LEVELS] ? 64'sd0 : acc) + tree[LEVELS][0];
             end
 
-            default: begin
-                state_next = IDLE;
+            assign done   = acc_valid;
+            assign result = acc;
+        end
+
+    end else begin : g_fsm
+        logic [BW-1:0] index, index_next;               // Fatia atual do vetor
+        logic signed [63:0] acc, acc_next;              // Acumulador da soma
+        logic signed [63:0] prod;                       // Soma dos produtos da fatia
+
+        logic done_reg, done_next;                      // Registrador para guardar sinal de done
+
+        // Sinais para a máquina de estado
+        typedef enum logic [1:0] {
+            IDLE,
+            CALC,
+            DONE
+        } state_type;
+        state_type state, state_next;
+
+        always_ff @(posedge clk, posedge rst) begin
+            if (rst) begin
+                state <= IDLE;
+                index <= 0;
+                acc   <= 0;
+                done_reg <= 0;
+            end else begin
+                state <= state_next;
+                index <= index_next;
+                acc   <= acc_next;
+                done_reg <= done_next;
             end
-        endcase
-    end
+        end
+
+
+
+        always_comb begin
+            prod = 0;
+            for (int i = 0; i < LANES; i++)
+                prod += A_v[int'(index)*LANES + i] * B_v[int'(index)*LANES + i];
+        end
+
+        always_comb begin
+            state_next = state;
+            index_next = index;
+            acc_next   = acc;
+            done_next  = done_reg;
+
+            case (state)
+                IDLE: begin
+                    done_next  = 0;
+                    if (start) begin
+                        state_next = CALC;
+                        index_next = 0;
+                        acc_next   = 0;
+                    end
+                end
+
+                CALC: begin
+                    acc_next   = acc + prod;
+                    index_next = index + 1'b1;
 
-    assign done = done_reg;
-    assign result = acc;
+                    if (index == BW'(BEATS - 1)) begin
+                        state_next = DONE;
+                        done_next = 1;
+                    end
+                end
+
+                DONE: begin
+                    if (!start)
+                        state_next = IDLE;      // Retorna ao IDLE apenas se start for desativado
+                end
+
+                default: begin
+                    state_next = IDLE;
+                end
+            endcase
+        end
+
+        assign ready = (state == IDLE);
+        assign done = done_reg;
+        assign result = acc;
+    end
+    endgenerate
 
-endmodule
\ No newline at end of file
+endmodule
@@ -0,0 +1,119 @@
+// Requantização de um acumulador int32 para a saída de uma camada TFLM:
+//     out = clamp(MultiplyByQuantizedMultiplier(acc + bias, multiplier, shift)
+//                 + output_offset, act_min, act_max)
+// com o mesmo arredondamento de tensorflow/lite/kernels/internal/common.cc,
+// bit a bit. SINGLE_ROUNDING escolhe a variante compilada com
+// TFLITE_SINGLE_ROUNDING=1; o padrão (0) é a versão gemmlowp,
+// RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(acc << left, M), right).
+//
+// Os parâmetros (bias, multiplier, shift, offset, limites) vêm de CSRs e devem
+// ficar estáveis enquanto houver dados no pipeline; apenas o acumulador avança
+// com `in_valid`. Latência fixa de LATENCY ciclos, um resultado por ciclo.
+module accelerator_requant #(
+    parameter bit SINGLE_ROUNDING = 1'b0
+) (
+    input logic clk, rst,
+
+    input  logic               in_valid,
+    input  logic signed [31:0] in_acc,          // Soma dos produtos (int32, modular)
+    input  logic signed [31:0] bias,
+    input  logic signed [31:0] multiplier,      // quantized_multiplier (>= 0, ponto fixo no bit 31)
+    input  logic signed [7:0]  shift,           // -31..30 (negativo: deslocamento à direita)
+    input  logic signed [31:0] output_offset,
+    input  logic signed [31:0] act_min,
+    input  logic signed [31:0] act_max,
+
+    output logic               out_valid,
+    output logic signed [31:0] out_data
+);
+
+    localparam int LATENCY = 4;
+
+    logic [LATENCY-1:0] valid;
+
+    // Estágio 1: soma do bias (int32, como o kernel de referência)
+    logic signed [31:0] acc1;
+    // Estágio 2: produto de 64 bits pelo multiplicador
+    logic signed [63:0] prod2;
+    // Estágio 3: escalonamento (parte alta do produto ou deslocamento único)
+    logic signed [31:0] scaled3;
+
+    logic [5:0] left_shift, right_shift;
+    assign left_shift  = (shift > 0) ? 6'(shift) : 6'd0;
+    assign right_shift = (shift > 0) ? 6'd0 : 6'(-shift);
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst)
+            valid <= '0;
+        else
+            valid <= {valid[LATENCY-2:0], in_valid};
+    end
+
+    always_ff @(posedge clk) begin
+        if (in_valid)
+            acc1 <= in_acc + bias;
+        if (valid[0]) begin
+            if (SINGLE_ROUNDING)
+                prod2 <= 64'(acc1) * 64'(multiplier);
+            else
+                prod2 <= 64'(signed'(acc1 <<< left_shift)) * 64'(multiplier);
+        end
+    end
+
+    generate
+    if (SINGLE_ROUNDING) begin : g_single
+        // (x * M + 2^(total_shift-1)) >> total_shift, total_shift = 31 - shift
+        logic [5:0]         total_shift;
+        logic signed [63:0] rounded;
+
+        assign total_shift = 6'(31 - int'(shift));
+        assign rounded     = prod2 + (64'sd1 <<< (total_shift - 1));
+
+        always_ff @(posedge clk) begin
+            if (valid[1])
+                scaled3 <= 32'(rounded >>> total_shift);
+        end
+
+        always_ff @(posedge clk) begin
+            if (valid[2])
+                out_data <= clamp(scaled3 + output_offset);
+        end
+    end else begin : g_double
+        // SaturatingRoundingDoublingHighMul: (ab + nudge) / 2^31 com divisão
+        // truncada em direção a zero. A saturação (a == b == INT32_MIN) não
+        // ocorre porque o multiplicador é sempre >= 0.
+        logic signed [63:0] nudged;
+        logic signed [63:0] towards_zero;
+
+        assign nudged       = prod2 + ((prod2 >= 0) ? 64'sd1073741824 : -64'sd1073741823);
+        assign towards_zero = (nudged < 0) ? nudged + 64'sd2147483647 : nudged;
+
+        always_ff @(posedge clk) begin
+            if (valid[1])
+                scaled3 <= 32'(towards_zero >>> 31);
+        end
+
+        // RoundingDivideByPOT: arredonda para o mais próximo, empates para longe de zero
+        logic signed [31:0] mask, remainder, threshold, divided;
+
+        assign mask      = 32'((64'sd1 <<< right_shift) - 1);
+        assign remainder = scaled3 & mask;
+        assign threshold = (mask >>> 1) + ((scaled3 < 0) ? 32'sd1 : 32'sd0);
+        assign divided   = (scaled3 >>> right_shift) + ((remainder > threshold) ? 32'sd1 : 32'sd0);
+
+        always_ff @(posedge clk) begin
+            if (valid[2])
+                out_data <= clamp(divided + output_offset);
+        end
+    end
+    endgenerate
+
+    assign out_valid = valid[LATENCY-1];
+
+    function automatic logic signed [31:0] clamp(input logic signed [31:0] v);
+        if (v < act_min) return act_min;
+        if (v > act_max) return act_max;
+        return v;
+    endfunction
+
+endmodule
@@ -0,0 +1,86 @@
+// Produto escalar em fluxo: recebe um par (a, b) por ciclo e acumula até o
+// elemento marcado com `in_last`. Usado pelas interfaces que entregam os
+// operandos um a um (DMA via Wishbone, FIFOs), em vez dos registradores
+// paralelos do módulo `accelerator`.
+//
+// Modo INT8 (parâmetro INT8=1 e `int8_mode` alto): cada palavra carrega quatro
+// valores int8 (elemento k em [8k +: 8]) e o MAC faz 4 produtos por ciclo,
+//     acc += (a_k + a_offset) * (b_k + b_offset),   k = 0..3
+// com acumulação em 32 bits (resultado estendido com sinal para 64 bits), a
+// mesma semântica de reference_integer_ops::FullyConnected com A = filtro
+// (a_offset = weights_offset) e B = entrada (b_offset = input_offset).
+module accelerator_stream #(
+    parameter bit INT8 = 1'b0                   // Sintetiza os multiplicadores do modo INT8
+) (
+    input logic clk, rst,
+
+    input  logic               int8_mode,       // 1: quatro int8 por palavra (requer INT8=1)
+    input  logic signed [15:0] a_offset,        // Somado a cada int8 de A no modo INT8
+    input  logic signed [15:0] b_offset,        // Somado a cada int8 de B no modo INT8
+
+    input  logic               in_valid,        // Par (a, b) válido neste ciclo
+    input  logic               in_last,         // Último par do vetor
+    input  logic signed [31:0] in_a,
+    input  logic signed [31:0] in_b,
+    output logic               in_ready,        // Sempre alto: um par por ciclo
+
+    output logic               out_valid,       // Pulso de um ciclo com o resultado
+    output logic signed [63:0] out_result
+);
+
+    // Latência fixa entre o par `in_last` e `out_valid`:
+    // 1 ciclo de multiplicação + 1 ciclo de acumulação.
+    localparam int LATENCY = 2;
+
+    logic signed [63:0] mac;                    // Produto (ou soma dos 4 produtos INT8) do par atual
+    logic               packed_mode;            // Modo INT8 efetivo
+
+    logic signed [63:0] prod;                   // Estágio 1: produto registrado
+    logic               prod_valid, prod_last, prod_first, prod_packed;
+    logic               first;                  // Próximo par é o primeiro de um vetor
+    logic signed [63:0] acc;                    // Estágio 2: acumulador
+    logic               acc_packed;
+
+    assign in_ready    = 1'b1;
+    assign packed_mode = INT8 && int8_mode;
+
+    always_comb begin
+        if (packed_mode) begin
+            mac = 0;
+            for (int k = 0; k < 4; k++)
+                mac += (signed'(in_a[8*k +: 8]) + a_offset) * (signed'(in_b[8*k +: 8]) + b_offset);
+        end else begin
+            mac = in_a * in_b;
+        end
+    end
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst) begin
+            first      <= 1'b1;
+            prod_valid <= 1'b0;
+            out_valid  <= 1'b0;
+        end else begin
+            if (in_valid)
+                first <= in_last;
+            prod_valid <= in_valid;
+            out_valid  <= prod_valid && prod_last;
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        if (in_valid) begin
+            prod        <= mac;
+            prod_last   <= in_last;
+            prod_first  <= first;
+            prod_packed <= packed_mode;
+        end
+        if (prod_valid) begin
+            acc        <= (prod_first ? 64'sd0 : acc) + prod;
+            acc_packed <= prod_packed;
+        end
+    end
+
+    // No modo INT8 o acumulador se comporta como int32 (aritmética modular)
+    assign out_result = acc_packed ? 64'(signed'(acc[31:0])) : acc;
+
+endmodule
@@ -0,0 +1,195 @@
+// Multiplicação de matrizes int8 em uma matriz sistólica ROWS x COLS
+// (output-stationary): C[i][j] = sum_k (A[i][k] + a_offset) * (B[k][j] + b_offset)
+// para um bloco de ROWS linhas de A e COLS colunas de B.
+//
+// Os operandos ficam em buffers locais, organizados por k: a palavra k*WA + w
+// de A guarda A[4w+3..4w][k] (linha 4w+r no byte r), e o mesmo vale para B com
+// as colunas. Assim um `start` reutiliza cada elemento de A em COLS produtos e
+// cada elemento de B em ROWS produtos. A linha i de A entra pela esquerda com i
+// ciclos de atraso e a coluna j de B entra por cima com j ciclos de atraso; o
+// PE (i, j) recebe o par de índice k no ciclo k + 1 + i + j.
+//
+// Cada PE acumula em int32 (aritmética modular, como os kernels int8 do TFLM).
+// Com `accumulate` alto o `start` mantém os acumuladores, o que permite dividir
+// K em blocos maiores que DEPTH. `done` pulsa por um ciclo quando C está pronto.
+module accelerator_systolic #(
+    parameter int ROWS  = 4,                    // Linhas de A (ex.: pixels de saída) por bloco
+    parameter int COLS  = 4,                    // Colunas de B (ex.: canais de saída) por bloco
+    parameter int DEPTH = 256,                  // Valores de k guardados nos buffers
+    localparam int WA   = (ROWS + 3) / 4,       // Palavras por valor de k em A
+    localparam int WB   = (COLS + 3) / 4,       // Palavras por valor de k em B
+    localparam int AAW  = $clog2(DEPTH * WA),
+    localparam int BAW  = $clog2(DEPTH * WB),
+    localparam int SW   = (ROWS * COLS > 1) ? $clog2(ROWS * COLS) : 1
+) (
+    input logic clk, rst,
+
+    // Escrita nos buffers locais: palavras de 32 bits (quatro int8)
+    input  logic                a_we,
+    input  logic [AAW-1:0]      a_waddr,
+    input  logic [31:0]         a_wdata,
+    input  logic                b_we,
+    input  logic [BAW-1:0]      b_waddr,
+    input  logic [31:0]         b_wdata,
+
+    input  logic                start,
+    input  logic                accumulate,     // 1: soma ao resultado anterior
+    input  logic [15:0]         k_len,          // 1..DEPTH
+    input  logic signed [15:0]  a_offset,       // Somado a cada elemento de A (input_offset)
+    input  logic signed [15:0]  b_offset,       // Somado a cada elemento de B (weights_offset)
+
+    output logic                busy,
+    output logic                done,
+
+    input  logic [SW-1:0]       res_sel,        // i*COLS + j
+    output logic signed [31:0]  res_data
+);
+
+    localparam int KW = $clog2(DEPTH);
+
+    // Ciclos entre o primeiro k lido e o último produto do PE (ROWS-1, COLS-1)
+    localparam int DRAIN = ROWS + COLS - 1;
+
+    // ---------------------------------------------------------------------
+    // Buffers locais (um banco por palavra de cada valor de k)
+    // ---------------------------------------------------------------------
+    logic [31:0] a_mem [WA][DEPTH];
+    logic [31:0] b_mem [WB][DEPTH];
+    logic [32*WA-1:0] a_rd;                     // A[*][k] lido no ciclo anterior
+    logic [32*WB-1:0] b_rd;
+    logic [KW-1:0]    rd_k;
+
+    always_ff @(posedge clk) begin
+        if (a_we)
+            a_mem[a_waddr % WA][a_waddr / WA] <= a_wdata;
+        if (b_we)
+            b_mem[b_waddr % WB][b_waddr / WB] <= b_wdata;
+        for (int w = 0; w < WA; w++)
+            a_rd[32*w +: 32] <= a_mem[w][rd_k];
+        for (int w = 0; w < WB; w++)
+            b_rd[32*w +: 32] <= b_mem[w][rd_k];
+    end
+
+    // ---------------------------------------------------------------------
+    // Sequenciador: lê k = 0..k_len-1 e espera o esvaziamento da matriz
+    // ---------------------------------------------------------------------
+    logic [16:0] cnt;
+    logic        reading, rd_valid;
+
+    assign reading = busy && (cnt < 17'(k_len));
+    assign rd_k    = KW'(cnt);
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst) begin
+            busy     <= 1'b0;
+            done     <= 1'b0;
+            cnt      <= '0;
+            rd_valid <= 1'b0;
+        end else begin
+            done     <= 1'b0;
+            rd_valid <= reading;
+            if (start && !busy) begin
+                busy <= 1'b1;
+                cnt  <= '0;
+            end else if (busy) begin
+                cnt <= cnt + 1'b1;
+                if (cnt == 17'(k_len) + 17'(DRAIN) - 17'd1) begin
+                    busy <= 1'b0;
+                    done <= 1'b1;
+                end
+            end
+        end
+    end
+
+    // ---------------------------------------------------------------------
+    // Bordas da matriz: offset e atraso de i ciclos na linha i (j na coluna j)
+    // ---------------------------------------------------------------------
+    logic signed [15:0] a_edge [ROWS];
+    logic               a_edge_v [ROWS];
+    logic signed [15:0] b_edge [COLS];
+    logic               b_edge_v [COLS];
+
+    for (genvar i = 0; i < ROWS; i++) begin : g_skew_a
+        logic signed [15:0] d   [i+1];
+        logic               d_v [i+1];
+        assign d[0]   = 16'(signed'(a_rd[8*i +: 8])) + a_offset;
+        assign d_v[0] = rd_valid;
+        for (genvar s = 1; s <= i; s++) begin : g_dly
+            always_ff @(posedge clk) begin
+                d[s]   <= d[s-1];
+                d_v[s] <= d_v[s-1];
+            end
+        end
+        assign a_edge[i]   = d[i];
+        assign a_edge_v[i] = d_v[i];
+    end
+
+    for (genvar j = 0; j < COLS; j++) begin : g_skew_b
+        logic signed [15:0] d   [j+1];
+        logic               d_v [j+1];
+        assign d[0]   = 16'(signed'(b_rd[8*j +: 8])) + b_offset;
+        assign d_v[0] = rd_valid;
+        for (genvar s = 1; s <= j; s++) begin : g_dly
+            always_ff @(posedge clk) begin
+                d[s]   <= d[s-1];
+                d_v[s] <= d_v[s-1];
+            end
+        end
+        assign b_edge[j]   = d[j];
+        assign b_edge_v[j] = d_v[j];
+    end
+
+    // ---------------------------------------------------------------------
+    // PEs: A anda para a direita, B para baixo, C fica no PE
+    // ---------------------------------------------------------------------
+    logic signed [15:0] a_reg [ROWS][COLS];
+    logic               a_v   [ROWS][COLS];
+    logic signed [15:0] b_reg [ROWS][COLS];
+    logic               b_v   [ROWS][COLS];
+    logic signed [31:0] acc   [ROWS*COLS];
+
+    for (genvar i = 0; i < ROWS; i++) begin : g_row
+        for (genvar j = 0; j < COLS; j++) begin : g_col
+            logic signed [15:0] a_in, b_in;
+            logic               a_in_v, b_in_v;
+
+            if (j == 0) begin : g_a_edge
+                assign a_in   = a_edge[i];
+                assign a_in_v = a_edge_v[i];
+            end else begin : g_a_left
+                assign a_in   = a_reg[i][j-1];
+                assign a_in_v = a_v[i][j-1];
+            end
+
+            if (i == 0) begin : g_b_edge
+                assign b_in   = b_edge[j];
+                assign b_in_v = b_edge_v[j];
+            end else begin : g_b_up
+                assign b_in   = b_reg[i-1][j];
+                assign b_in_v = b_v[i-1][j];
+            end
+
+            always_ff @(posedge clk) begin
+                a_reg[i][j] <= a_in;
+                b_reg[i][j] <= b_in;
+                if (start && !busy && !accumulate)
+                    acc[i*COLS + j] <= '0;
+                else if (a_in_v && b_in_v)
+                    acc[i*COLS + j] <= acc[i*COLS + j] + 32'(a_in * b_in);
+            end
+
+            always_ff @(posedge clk, posedge rst) begin
+                if (rst) begin
+                    a_v[i][j] <= 1'b0;
+                    b_v[i][j] <= 1'b0;
+                end else begin
+                    a_v[i][j] <= a_in_v;
+                    b_v[i][j] <= b_in_v;
+                end
+            end
+        end
+    end
+
+    assign res_data = acc[res_sel];
+
+endmodule
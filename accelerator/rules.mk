@@ -4,6 +4,7 @@
 VERILATOR_FLAGS += -Wall -Wno-fatal -j 0
 VERILATOR_SIM_FLAGS += --binary --timing --trace-vcd --Mdir $(BUILDDIR)
 VERILATOR_LINT_FLAGS += --lint-only
+VERILATOR_REGRESS_FLAGS += --cc --exe --build -O3
 
 # -------------------------------
 # Toolchain
@@ -62,7 +63,57 @@ prog: $(BIT).bit
 $(SIM_EXE): $(SRCS) $(TB) | $(BUILDDIR)
 	$(VERILATOR) $(VERILATOR_FLAGS) $(VERILATOR_SIM_FLAGS) $(SRCS) $(TB) --top-module tb_$(TOP) -o $@
 
-sim: $(SIM_EXE)
+# -------------------------------
+# Regressão aleatória em C++ (REGRESS_SRC), uma build por configuração.
+# REGRESS_CONFIGS: nome:PARAM=valor,PARAM=valor... (cada PARAM vira -G e -D)
+# -------------------------------
+comma          := ,
+regress_name    = $(word 1,$(subst :, ,$(1)))
+regress_params  = $(subst $(comma), ,$(word 2,$(subst :, ,$(1))))
+regress_exe     = $(BUILDDIR)/regress_$(call regress_name,$(1))/V$(TOP)
+
+define REGRESS_RULE
+$(call regress_exe,$(1)): $(SRCS) $(REGRESS_SRC) | $(BUILDDIR)
+	$(VERILATOR) $(VERILATOR_FLAGS) $(VERILATOR_REGRESS_FLAGS) --Mdir $$(@D) \
+		$(addprefix -G,$(call regress_params,$(1))) -CFLAGS "$(addprefix -D,$(call regress_params,$(1)))" \
+		$(SRCS) $(abspath $(REGRESS_SRC)) --top-module $(TOP) -o V$(TOP)
+endef
+
+REGRESS_EXES = $(foreach cfg,$(REGRESS_CONFIGS),$(call regress_exe,$(cfg)))
+$(foreach cfg,$(REGRESS_CONFIGS),$(eval $(call REGRESS_RULE,$(cfg))))
+
+regress: $(REGRESS_EXES)
+	$(foreach exe,$(REGRESS_EXES),$(exe) $(REGRESS_ARGS) &&) true
+
+# -------------------------------
+# Caracterização: yosys + nextpnr fora de contexto (sem pinos) por configuração
+# de CHARACTERIZE_CONFIGS (nome:módulo:PARAM=valor,...), relatório em CSV.
+# O Fmax é o alcançado, não só o alvo: --timing-allow-fail deixa o fluxo seguir.
+# -------------------------------
+CHARACTERIZE_CSV   = $(BUILDDIR)/characterize.csv
+char_name          = $(word 1,$(subst :, ,$(1)))
+char_top           = $(word 2,$(subst :, ,$(1)))
+char_params        = $(subst $(comma), ,$(word 3,$(subst :, ,$(1))))
+char_dir           = $(BUILDDIR)/char_$(call char_name,$(1))
+
+define CHARACTERIZE_RULE
+$(call char_dir,$(1))/report.json: $(SRCS) | $(BUILDDIR)
+	mkdir -p $$(@D)
+	$(YOSYS) -q -l $$(@D)/yosys.log -p "read_verilog -sv $(SRCS); \
+		$(if $(call char_params,$(1)),chparam $(foreach p,$(call char_params,$(1)),-set $(subst =, ,$(p))) $(call char_top,$(1));) \
+		synth_ecp5 -top $(call char_top,$(1)) -json $$(@D)/synth.json; tee -q -o $$(@D)/stat.txt stat"
+	$(NEXTPNR) --45k --package CABGA381 --speed 6 --out-of-context --timing-allow-fail \
+		--freq $(CHARACTERIZE_FREQ) --json $$(@D)/synth.json --report $$@ --log $$(@D)/nextpnr.log --quiet
+endef
+
+CHARACTERIZE_REPORTS = $(foreach cfg,$(CHARACTERIZE_CONFIGS),$(call char_dir,$(cfg))/report.json)
+$(foreach cfg,$(CHARACTERIZE_CONFIGS),$(eval $(call CHARACTERIZE_RULE,$(cfg))))
+
+characterize: $(CHARACTERIZE_REPORTS)
+	python3 tools/characterize.py $(CHARACTERIZE_CSV) \
+		$(foreach cfg,$(CHARACTERIZE_CONFIGS),$(call char_dir,$(cfg)):$(cfg))
+
+sim: $(SIM_EXE) regress
 	$(BUILDDIR)/$(SIM_EXE)
 
 # -------------------------------
@@ -83,4 +134,4 @@ $(BUILDDIR):
 clean:
 	rm -rf $(BUILDDIR)
 
-.PHONY: all prog sim wave clean
+.PHONY: all prog sim regress characterize wave clean
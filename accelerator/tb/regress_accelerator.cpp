@@ -0,0 +1,246 @@
+// Regressão aleatória do acelerador (Verilator, C++).
+//
+// Injeta milhões de pares de vetores no módulo `accelerator` e confere cada
+// resultado com um modelo de referência (soma dos produtos de 64 bits, em
+// aritmética modular como o hardware). Metade dos vetores é uniforme; o resto
+// mistura casos de canto: INT32_MIN/INT32_MAX, vetores que estouram a soma de
+// 64 bits, sinais alternados e valores pequenos. No fim mostra a vazão medida
+// (ciclos por resultado e resultados por segundo no clock de síntese) e falha
+// se ela for pior que a esperada para a configuração.
+//
+// Os parâmetros do núcleo chegam por -D (os mesmos -G passados ao Verilator):
+// VECTOR_LEN, LANES e PIPELINED. Argumentos: +n=<vetores> +seed=<semente>
+// +freq_mhz=<clock usado para converter ciclos em tempo>.
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <type_traits>
+
+#include "Vaccelerator.h"
+#include "verilated.h"
+
+#ifndef VECTOR_LEN
+#define VECTOR_LEN 8
+#endif
+#ifndef LANES
+#define LANES (PIPELINED ? VECTOR_LEN : 1)
+#endif
+#ifndef PIPELINED
+#define PIPELINED 0
+#endif
+
+namespace {
+
+constexpr int kBeats = VECTOR_LEN / LANES;
+
+// Ciclos por resultado esperados (ver accelerator.sv): o pipeline aceita uma
+// fatia por ciclo; a FSM gasta kBeats ciclos em CALC, um em DONE (até `start`
+// baixar) e um em IDLE antes de aceitar o próximo `start`.
+constexpr int kCyclesPerResult = PIPELINED ? kBeats : kBeats + 2;
+
+struct Vectors {
+  int32_t a[VECTOR_LEN];
+  int32_t b[VECTOR_LEN];
+};
+
+int64_t Golden(const Vectors& v) {
+  uint64_t acc = 0;
+  for (int i = 0; i < VECTOR_LEN; i++)
+    acc += static_cast<uint64_t>(static_cast<int64_t>(v.a[i]) * v.b[i]);
+  return static_cast<int64_t>(acc);
+}
+
+class Stimulus {
+ public:
+  explicit Stimulus(uint32_t seed) : rng_(seed) {}
+
+  void Next(Vectors& v) {
+    switch (Pick(8)) {
+      case 0:  // Só os extremos de int32
+        for (int i = 0; i < VECTOR_LEN; i++) {
+          v.a[i] = Corner();
+          v.b[i] = Corner();
+        }
+        break;
+      case 1:  // INT32_MIN * INT32_MIN = 2^62: a soma estoura a partir de 2 elementos
+        for (int i = 0; i < VECTOR_LEN; i++) {
+          v.a[i] = INT32_MIN;
+          v.b[i] = Pick(4) ? INT32_MIN : Corner();
+        }
+        break;
+      case 2: {  // Produtos >= 2^60 de mesmo sinal: a soma passa por INT64_MAX/INT64_MIN
+        int32_t sign = Pick(2) ? 1 : -1;
+        for (int i = 0; i < VECTOR_LEN; i++) {
+          v.a[i] = static_cast<int32_t>(0x40000000u | (Word() & 0x3fffffffu));
+          v.b[i] = sign * static_cast<int32_t>(0x40000000u | (Word() & 0x3fffffffu));
+        }
+        break;
+      }
+      case 3:  // Sinais alternados e magnitudes pequenas
+        for (int i = 0; i < VECTOR_LEN; i++) {
+          v.a[i] = static_cast<int32_t>(Pick(256)) * ((i & 1) ? -1 : 1);
+          v.b[i] = static_cast<int32_t>(Pick(256)) - 128;
+        }
+        break;
+      default:  // Uniforme
+        for (int i = 0; i < VECTOR_LEN; i++) {
+          v.a[i] = static_cast<int32_t>(Word());
+          v.b[i] = static_cast<int32_t>(Word());
+        }
+        break;
+    }
+  }
+
+ private:
+  uint32_t Word() { return static_cast<uint32_t>(rng_()); }
+  uint32_t Pick(uint32_t n) { return Word() % n; }
+  int32_t Corner() {
+    static const int32_t kCorners[] = {INT32_MIN, INT32_MIN + 1, -1, 0, 1, INT32_MAX - 1, INT32_MAX};
+    return kCorners[Pick(sizeof(kCorners) / sizeof(kCorners[0]))];
+  }
+
+  std::mt19937 rng_;
+};
+
+// Portas de VECTOR_LEN*32 bits: uint32 (1 elemento), uint64 (2) ou VlWide
+template <typename Port>
+void SetVector(Port& port, const int32_t* v) {
+  if constexpr (std::is_integral_v<Port>) {
+    uint64_t bits = 0;
+    for (int i = 0; i < VECTOR_LEN; i++)
+      bits |= static_cast<uint64_t>(static_cast<uint32_t>(v[i])) << (32 * i);
+    port = static_cast<Port>(bits);
+  } else {
+    for (int i = 0; i < VECTOR_LEN; i++)
+      port[i] = static_cast<uint32_t>(v[i]);
+  }
+}
+
+long ArgValue(int argc, char** argv, const char* name, long fallback) {
+  size_t len = std::strlen(name);
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] == '+' && std::strncmp(argv[i] + 1, name, len) == 0 && argv[i][len + 1] == '=')
+      return std::strtol(argv[i] + len + 2, nullptr, 0);
+  }
+  return fallback;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto context = std::make_unique<VerilatedContext>();
+  context->commandArgs(argc, argv);
+  const auto top = std::make_unique<Vaccelerator>(context.get());
+
+  const long n_vectors = ArgValue(argc, argv, "n", 1000000);
+  const long seed = ArgValue(argc, argv, "seed", 1);
+  const long freq_mhz = ArgValue(argc, argv, "freq_mhz", 65);
+
+  std::printf("accelerator VECTOR_LEN=%d LANES=%d PIPELINED=%d: %ld vetores, semente %ld\n",
+              VECTOR_LEN, LANES, PIPELINED, n_vectors, seed);
+
+  Stimulus stimulus(static_cast<uint32_t>(seed));
+  Vectors v;
+  std::deque<int64_t> expected;
+  long sent = 0, checked = 0, errors = 0;
+  uint64_t cycle = 0, first_start = 0, first_done = 0, last_done = 0;
+  bool waiting = false;
+
+  auto tick = [&] {
+    top->clk = 1;
+    top->eval();
+    cycle++;
+    top->clk = 0;
+    top->eval();
+  };
+
+  top->clk = 0;
+  top->start = 0;
+  top->rst = 1;
+  top->eval();
+  tick();
+  top->rst = 0;
+  tick();
+
+  const uint64_t timeout = static_cast<uint64_t>(n_vectors + 16) * (kCyclesPerResult + 16);
+  uint64_t start_cycle = cycle;
+  while (checked < n_vectors && !context->gotFinish()) {
+    // Estímulo com o clock baixo, a partir das saídas registradas do ciclo anterior
+    if (PIPELINED) {
+      top->start = 0;
+      if (top->ready && sent < n_vectors) {
+        stimulus.Next(v);
+        SetVector(top->a, v.a);
+        SetVector(top->b, v.b);
+        top->start = 1;
+        expected.push_back(Golden(v));
+        if (sent++ == 0) first_start = cycle + 1;  // Borda que aceita o `start`
+      }
+    } else if (waiting && top->done) {
+      top->start = 0;
+      waiting = false;
+    } else if (!waiting && top->ready && sent < n_vectors) {
+      stimulus.Next(v);
+      SetVector(top->a, v.a);
+      SetVector(top->b, v.b);
+      top->start = 1;
+      expected.push_back(Golden(v));
+      waiting = true;
+      if (sent++ == 0) first_start = cycle + 1;  // Borda que aceita o `start`
+    }
+    top->eval();
+    tick();
+
+    // No modo FSM `done` fica alto até `start` baixar: conta apenas a subida
+    bool result_valid = PIPELINED ? top->done : (top->done && waiting && !expected.empty());
+    if (result_valid) {
+      if (expected.empty()) {
+        std::printf(">> FALHA: done inesperado no ciclo %" PRIu64 "\n", cycle);
+        errors++;
+      } else {
+        int64_t result = static_cast<int64_t>(top->result);
+        if (result != expected.front()) {
+          if (errors < 10)
+            std::printf(">> FALHA: resultado %ld = %" PRId64 ", esperado %" PRId64 "\n", checked,
+                        result, expected.front());
+          errors++;
+        }
+        expected.pop_front();
+        if (checked++ == 0) first_done = cycle;
+        last_done = cycle;
+      }
+    }
+
+    if (cycle - start_cycle > timeout) {
+      std::printf(">> FALHA: timeout com %ld de %ld resultados\n", checked, n_vectors);
+      errors++;
+      break;
+    }
+  }
+  top->final();
+
+  // Vazão em regime: do primeiro ao último resultado (a latência fica de fora)
+  double cycles_per_result =
+      checked > 1 ? static_cast<double>(last_done - first_done) / (checked - 1) : 0.0;
+  double results_per_second = cycles_per_result > 0 ? freq_mhz * 1e6 / cycles_per_result : 0.0;
+  std::printf("Latencia do primeiro resultado: %" PRIu64 " ciclos\n", first_done - first_start);
+  std::printf("Ciclos por resultado: %.3f (esperado %d)\n", cycles_per_result, kCyclesPerResult);
+  std::printf("Resultados por segundo a %ld MHz: %.0f (%.0f MAC/s)\n", freq_mhz, results_per_second,
+              results_per_second * VECTOR_LEN);
+
+  if (checked > 1 && cycles_per_result > kCyclesPerResult + 1e-9) {
+    std::printf(">> FALHA: vazao abaixo da esperada\n");
+    errors++;
+  }
+  if (errors == 0)
+    std::printf(">> SUCESSO: %ld resultados conferidos\n", checked);
+  else
+    std::printf(">> FALHA: %ld erro(s)\n", errors);
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+
+# Junta os relatórios do `make characterize` em uma tabela CSV.
+#
+# Uso: characterize.py <saida.csv> <dir>:<nome>:<módulo>:<PARAM=valor,...> ...
+#
+# Para cada configuração lê o relatório JSON do nextpnr (`report.json`:
+# utilização das células e Fmax alcançado por clock) e, como reserva, o `stat`
+# do yosys (`stat.txt`). A vazão é estimada a partir dos parâmetros, com o
+# mesmo modelo de ciclos da regressão (tb/regress_accelerator.cpp): o pipeline
+# aceita uma fatia de LANES elementos por ciclo e a FSM gasta VECTOR_LEN/LANES
+# ciclos em CALC mais 2 de handshake por vetor; o núcleo em fluxo faz um MAC
+# por ciclo (quatro no modo INT8).
+
+import csv
+import json
+import os
+import re
+import sys
+
+# Células do ECP5 contadas na tabela (nome no nextpnr, coluna)
+CELLS = [
+    ("TRELLIS_COMB", "luts"),
+    ("TRELLIS_FF",   "ffs"),
+    ("MULT18X18D",   "dsps"),
+    ("DP16KD",       "ebrs"),
+]
+
+def parse_config(arg):
+    directory, name, top, params = (arg.split(":") + [""])[:4]
+    params = dict(p.split("=") for p in params.split(",") if p)
+    return directory, name, top, {k: int(v) for k, v in params.items()}
+
+def macs_per_cycle(top, params):
+    if top == "accelerator":
+        vector_len = params.get("VECTOR_LEN", 8)
+        pipelined  = params.get("PIPELINED", 0)
+        lanes      = params.get("LANES", vector_len if pipelined else 1)
+        beats      = vector_len // lanes
+        return vector_len / (beats if pipelined else beats + 2)
+    if top == "accelerator_stream":
+        return 4 if params.get("INT8", 0) else 1
+    return None
+
+def read_report(directory):
+    cells = {}
+    fmax  = None
+    path  = os.path.join(directory, "report.json")
+    if os.path.exists(path):
+        with open(path) as f:
+            report = json.load(f)
+        for cell, usage in report.get("utilization", {}).items():
+            cells[cell] = usage.get("used", 0)
+        achieved = [clk["achieved"] for clk in report.get("fmax", {}).values() if "achieved" in clk]
+        if achieved:
+            fmax = min(achieved)
+    # Sem o relatório do nextpnr, contagem pós-síntese do yosys (LUT4 no lugar de TRELLIS_COMB)
+    path = os.path.join(directory, "stat.txt")
+    if not cells and os.path.exists(path):
+        with open(path) as f:
+            for line in f:
+                m = re.match(r"\s+(\w+)\s+(\d+)\s*$", line)
+                if m:
+                    cells[{"LUT4": "TRELLIS_COMB"}.get(m.group(1), m.group(1))] = int(m.group(2))
+    return cells, fmax
+
+def main():
+    if len(sys.argv) < 3:
+        print("Uso: characterize.py <saida.csv> <dir>:<nome>:<módulo>:<PARAM=valor,...> ...")
+        sys.exit(1)
+
+    rows = []
+    for arg in sys.argv[2:]:
+        directory, name, top, params = parse_config(arg)
+        cells, fmax = read_report(directory)
+        macs = macs_per_cycle(top, params)
+        row = dict(
+            config = name,
+            top    = top,
+            params = " ".join(f"{k}={v}" for k, v in params.items()),
+        )
+        for cell, column in CELLS:
+            row[column] = cells.get(cell, 0)
+        row["fmax_mhz"]       = f"{fmax:.2f}" if fmax is not None else ""
+        row["macs_per_cycle"] = f"{macs:.3f}" if macs is not None else ""
+        row["mmacs_per_s"]    = f"{fmax*macs:.1f}" if fmax is not None and macs is not None else ""
+        rows.append(row)
+
+    columns = ["config", "top", "params"] + [c for _, c in CELLS] + ["fmax_mhz", "macs_per_cycle", "mmacs_per_s"]
+    with open(sys.argv[1], "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        writer.writerows(rows)
+
+    # Mesma tabela no terminal
+    widths = {c: max(len(c), *(len(str(r[c])) for r in rows)) for c in columns}
+    print("  ".join(c.ljust(widths[c]) for c in columns).rstrip())
+    for r in rows:
+        print("  ".join(str(r[c]).ljust(widths[c]) for c in columns).rstrip())
+    print(f"Tabela em {sys.argv[1]}")
+
+if __name__ == "__main__":
+    main()
@@ -35,12 +35,15 @@ extern "C" {
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/micro/system_setup.h"
 #include "tensorflow/lite/schema/schema_generated.h"
+#include "litex_fully_connected.h"
 
 namespace {
 using HelloWorldOpResolver = tflite::MicroMutableOpResolver<1>;
 
 TfLiteStatus RegisterOps(HelloWorldOpResolver& op_resolver) {
-  TF_LITE_ENSURE_STATUS(op_resolver.AddFullyConnected());
+  // Offloads int8 layers to the accelerator when the SoC has one
+  TF_LITE_ENSURE_STATUS(
+      op_resolver.AddFullyConnected(tflite::Register_FULLY_CONNECTED_LITEX()));
   return kTfLiteOk;
 }
 }  // namespace
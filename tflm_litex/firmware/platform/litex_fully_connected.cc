@@ -0,0 +1,410 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+/*
+ * LiteX FullyConnected kernel backed by the dot-product accelerator
+ *
+ * The int8 x int8 inner products go to the hardware, with input_offset (and
+ * weights_offset for per-tensor filters) folded into the operands. Bias,
+ * requantization and clamping run on the accelerator's requantization stage
+ * when the SoC has one, and in software otherwise. Either way the output
+ * matches reference_integer_ops::FullyConnected{,PerChannel} bit for bit.
+ */
+
+#include "litex_fully_connected.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+
+extern "C" {
+#include <system.h>
+#include <generated/csr.h>
+#include <generated/soc.h>
+}
+#ifdef CSR_ACCELERATOR_BASE
+#include <generated/accel_driver.h>
+#endif
+
+namespace tflite {
+namespace {
+
+#ifdef CSR_ACCELERATOR_BASE
+
+// Elements per job in the CSR window (a0..aN-1, b0..bN-1, contiguous).
+constexpr int kAccelN = ACCEL_VECTOR_LEN;
+
+struct OpDataLitexFullyConnected {
+  // user_data of the wrapped FULLY_CONNECTED kernel. Its OpData may be larger
+  // than OpDataFullyConnected (optimized kernels), so it is allocated by that
+  // kernel's own Init; it starts with the common OpDataFullyConnected.
+  void* fully_connected;
+  // Per-output-channel int32 accumulators while accum_depth is tiled.
+  int acc_buffer_index;
+};
+
+// Runs the wrapped kernel's prepare/invoke with its own user_data.
+TfLiteStatus Delegate(TfLiteStatus (*fn)(TfLiteContext*, TfLiteNode*),
+                      TfLiteContext* context, TfLiteNode* node) {
+  void* user_data = node->user_data;
+  node->user_data =
+      static_cast<OpDataLitexFullyConnected*>(user_data)->fully_connected;
+  const TfLiteStatus status = fn(context, node);
+  node->user_data = user_data;
+  return status;
+}
+
+// Runs one job on the operands already in the window. The reference kernel
+// accumulates in int32, so the low word of the 64-bit result is all we need.
+inline int32_t AccelRun() {
+  accel_start();
+  return static_cast<int32_t>(accel_wait());
+}
+
+// Requantization parameters of one output channel.
+inline void ChannelMultiplier(const OpDataFullyConnected& data, int out_c,
+                              int32_t* multiplier, int* shift) {
+  if (data.is_per_channel) {
+    *multiplier = data.per_channel_output_multiplier[out_c];
+    *shift = data.per_channel_output_shift[out_c];
+  } else {
+    *multiplier = data.output_multiplier;
+    *shift = data.output_shift;
+  }
+}
+
+// Bias, requantization and clamping of one output row, as in
+// reference_integer_ops::FullyConnected.
+void RequantizeRow(const OpDataFullyConnected& data, const int32_t* acc,
+                   const int32_t* bias_data, int output_depth,
+                   int8_t* output_row) {
+  for (int out_c = 0; out_c < output_depth; ++out_c) {
+    int32_t acc_scaled = acc[out_c];
+    if (bias_data) {
+      acc_scaled += bias_data[out_c];
+    }
+    int32_t multiplier;
+    int shift;
+    ChannelMultiplier(data, out_c, &multiplier, &shift);
+    acc_scaled = MultiplyByQuantizedMultiplier(acc_scaled, multiplier, shift);
+    acc_scaled += data.output_zero_point;
+    acc_scaled = std::max(acc_scaled, data.output_activation_min);
+    acc_scaled = std::min(acc_scaled, data.output_activation_max);
+    output_row[out_c] = static_cast<int8_t>(acc_scaled);
+  }
+}
+
+#ifdef CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+inline uint32_t AccelAddress(const volatile void* p) {
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p));
+}
+
+// The DMA front-end writes the 64-bit result here.
+volatile int64_t dma_result __attribute__((aligned(8)));
+
+// One row per DMA job: the INT8 mode reads four int8 per bus word, so both
+// operands must be word aligned and accum_depth a multiple of 4.
+bool DmaInt8Usable(const int8_t* input, const int8_t* filter,
+                   int accum_depth) {
+  return (accum_depth % 4) == 0 &&
+         (reinterpret_cast<uintptr_t>(input) % 4) == 0 &&
+         (reinterpret_cast<uintptr_t>(filter) % 4) == 0;
+}
+
+// One DMA job per output channel. With the DMA requantization stage the
+// result written to memory is already the int8 activation and output_row is
+// filled directly; otherwise the raw sums go to acc. Returns true when
+// output_row was written.
+bool EvalDmaInt8(const OpDataFullyConnected& data, const int8_t* input,
+                 const int8_t* filter, const int32_t* bias_data,
+                 int accum_depth, int output_depth, int32_t input_offset,
+                 int32_t weights_offset, int32_t* acc, int8_t* output_row) {
+  accelerator_dma_int8_enable_write(1);
+  accelerator_dma_int8_a_offset_write(static_cast<uint16_t>(weights_offset));
+  accelerator_dma_int8_b_offset_write(static_cast<uint16_t>(input_offset));
+  accelerator_dma_a_stride_write(1);
+  accelerator_dma_b_stride_write(1);
+  accelerator_dma_length_write(accum_depth / 4);
+  accelerator_dma_b_base_write(AccelAddress(input));
+  accelerator_dma_result_base_write(AccelAddress(&dma_result));
+#ifdef CSR_ACCELERATOR_DMA_REQUANT_ENABLE_ADDR
+  accelerator_dma_requant_output_offset_write(data.output_zero_point);
+  accelerator_dma_requant_act_min_write(data.output_activation_min);
+  accelerator_dma_requant_act_max_write(data.output_activation_max);
+  accelerator_dma_requant_enable_write(1);
+#endif
+
+  // The input was just produced by the previous layer.
+  flush_cpu_dcache();
+  for (int out_c = 0; out_c < output_depth; ++out_c) {
+#ifdef CSR_ACCELERATOR_DMA_REQUANT_ENABLE_ADDR
+    int32_t multiplier;
+    int shift;
+    ChannelMultiplier(data, out_c, &multiplier, &shift);
+    accelerator_dma_requant_bias_write(bias_data ? bias_data[out_c] : 0);
+    accelerator_dma_requant_multiplier_write(multiplier);
+    accelerator_dma_requant_shift_write(static_cast<uint8_t>(shift));
+#endif
+    accelerator_dma_a_base_write(AccelAddress(filter + out_c * accum_depth));
+    accelerator_dma_start_write(1);
+    while (!accelerator_dma_done_read()) {
+    }
+    flush_cpu_dcache();
+#ifdef CSR_ACCELERATOR_DMA_REQUANT_ENABLE_ADDR
+    output_row[out_c] = static_cast<int8_t>(dma_result);
+#else
+    acc[out_c] = static_cast<int32_t>(dma_result);
+#endif
+  }
+  accelerator_dma_int8_enable_write(0);
+#ifdef CSR_ACCELERATOR_DMA_REQUANT_ENABLE_ADDR
+  accelerator_dma_requant_enable_write(0);
+  return true;
+#else
+  return false;
+#endif
+}
+#endif  // CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+
+// Writes input[0, len) to the B window. The tail is zeroed so stale A values
+// do not contribute.
+inline void LoadInputTile(const int8_t* input, int len, int32_t input_offset) {
+  volatile uint32_t* window = ACCEL_B_WINDOW;
+  for (int i = 0; i < kAccelN; ++i) {
+    window[i] = i < len ? input[i] + input_offset : 0;
+  }
+}
+
+inline void LoadFilterTile(const int8_t* row, int len,
+                           int32_t weights_offset) {
+  volatile uint32_t* window = ACCEL_A_WINDOW;
+  for (int i = 0; i < len; ++i) {
+    window[i] = row[i] + weights_offset;
+  }
+}
+
+// acc[out_c] = sum_{d < depth} (filter[out_c][d] + weights_offset) *
+//                              (input[d] + input_offset)
+// The depth is split in tiles of kAccelN elements. Each input tile is
+// written once and reused by every output channel.
+void AccumulateCsrWindow(const int8_t* input, const int8_t* filter,
+                         int accum_depth, int depth, int output_depth,
+                         int32_t input_offset, int32_t weights_offset,
+                         int32_t* acc) {
+  for (int d0 = 0; d0 < depth; d0 += kAccelN) {
+    const int len = std::min(kAccelN, depth - d0);
+    LoadInputTile(input + d0, len, input_offset);
+    for (int out_c = 0; out_c < output_depth; ++out_c) {
+      LoadFilterTile(filter + out_c * accum_depth + d0, len, weights_offset);
+      const int32_t partial = AccelRun();
+      acc[out_c] = (d0 == 0) ? partial : acc[out_c] + partial;
+    }
+  }
+}
+
+// Same tiling, but the last tile of every output channel goes through the
+// requantization stage. Its bias CSR carries the layer bias plus the partial
+// sum of the previous tiles, so result_lo is the final int8 activation.
+// Returns true when output_row was written.
+bool EvalCsrWindow(const OpDataFullyConnected& data, const int8_t* input,
+                   const int8_t* filter, const int32_t* bias_data,
+                   int accum_depth, int output_depth, int32_t input_offset,
+                   int32_t weights_offset, int32_t* acc, int8_t* output_row) {
+#ifdef CSR_ACCELERATOR_REQUANT_ENABLE_ADDR
+  const int last_d0 = ((accum_depth - 1) / kAccelN) * kAccelN;
+  const int len = accum_depth - last_d0;
+  AccumulateCsrWindow(input, filter, accum_depth, last_d0, output_depth,
+                      input_offset, weights_offset, acc);
+
+  LoadInputTile(input + last_d0, len, input_offset);
+  accelerator_requant_output_offset_write(data.output_zero_point);
+  accelerator_requant_act_min_write(data.output_activation_min);
+  accelerator_requant_act_max_write(data.output_activation_max);
+  accelerator_requant_enable_write(1);
+  for (int out_c = 0; out_c < output_depth; ++out_c) {
+    int32_t multiplier;
+    int shift;
+    ChannelMultiplier(data, out_c, &multiplier, &shift);
+    const int32_t carry = (last_d0 > 0 ? acc[out_c] : 0) +
+                          (bias_data ? bias_data[out_c] : 0);
+    accelerator_requant_bias_write(carry);
+    accelerator_requant_multiplier_write(multiplier);
+    accelerator_requant_shift_write(static_cast<uint8_t>(shift));
+    LoadFilterTile(filter + out_c * accum_depth + last_d0, len,
+                   weights_offset);
+    output_row[out_c] = static_cast<int8_t>(AccelRun());
+  }
+  accelerator_requant_enable_write(0);
+  return true;
+#else
+  AccumulateCsrWindow(input, filter, accum_depth, accum_depth, output_depth,
+                      input_offset, weights_offset, acc);
+  return false;
+#endif
+}
+
+void EvalInt8Accelerated(const OpDataFullyConnected& data,
+                         const TfLiteEvalTensor* input,
+                         const TfLiteEvalTensor* filter,
+                         const TfLiteEvalTensor* bias,
+                         TfLiteEvalTensor* output, int32_t* acc) {
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
+  const int filter_dim_count = filter_shape.DimensionsCount();
+  const int output_dim_count = output_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dim_count - 1);
+  const int output_depth = output_shape.Dims(output_dim_count - 1);
+  const int accum_depth = filter_shape.Dims(filter_dim_count - 1);
+
+  const int8_t* input_data = tflite::micro::GetTensorData<int8_t>(input);
+  const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(filter);
+  const int32_t* bias_data =
+      tflite::micro::GetOptionalTensorData<int32_t>(bias);
+  int8_t* output_data = tflite::micro::GetTensorData<int8_t>(output);
+
+  const int32_t input_offset = -data.input_zero_point;
+  // Per-channel filters are symmetric: the reference kernel ignores the
+  // filter zero point there.
+  const int32_t weights_offset =
+      data.is_per_channel ? 0 : -data.filter_zero_point;
+
+  for (int b = 0; b < batches; ++b) {
+    const int8_t* input_row = input_data + b * accum_depth;
+    int8_t* output_row = output_data + b * output_depth;
+    bool requantized;
+#ifdef CSR_ACCELERATOR_DMA_INT8_ENABLE_ADDR
+    if (DmaInt8Usable(input_row, filter_data, accum_depth)) {
+      requantized = EvalDmaInt8(data, input_row, filter_data, bias_data,
+                                accum_depth, output_depth, input_offset,
+                                weights_offset, acc, output_row);
+    } else
+#endif
+    {
+      requantized = EvalCsrWindow(data, input_row, filter_data, bias_data,
+                                  accum_depth, output_depth, input_offset,
+                                  weights_offset, acc, output_row);
+    }
+    if (!requantized) {
+      RequantizeRow(data, acc, bias_data, output_depth, output_row);
+    }
+  }
+}
+
+bool IsAcceleratedInt8(const TfLiteEvalTensor* input,
+                       const TfLiteEvalTensor* filter) {
+  return input->type == kTfLiteInt8 && filter->type == kTfLiteInt8;
+}
+
+void* LitexFullyConnectedInit(TfLiteContext* context, const char* buffer,
+                              size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataLitexFullyConnected*>(
+      context->AllocatePersistentBuffer(context,
+                                        sizeof(OpDataLitexFullyConnected)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  data->fully_connected =
+      Register_FULLY_CONNECTED().init(context, buffer, length);
+  return data;
+}
+
+TfLiteStatus LitexFullyConnectedPrepare(TfLiteContext* context,
+                                        TfLiteNode* node) {
+  TF_LITE_ENSURE_OK(context, Delegate(Register_FULLY_CONNECTED().prepare,
+                                      context, node));
+
+  auto* data = static_cast<OpDataLitexFullyConnected*>(node->user_data);
+  data->acc_buffer_index = -1;
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kFullyConnectedInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter = micro_context->AllocateTempInputTensor(
+      node, kFullyConnectedWeightsTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  TfLiteTensor* output = micro_context->AllocateTempOutputTensor(
+      node, kFullyConnectedOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  if (input->type == kTfLiteInt8 && filter->type == kTfLiteInt8) {
+    const int output_depth = output->dims->data[output->dims->size - 1];
+    TF_LITE_ENSURE_OK(context, context->RequestScratchBufferInArena(
+                                   context, output_depth * sizeof(int32_t),
+                                   &data->acc_buffer_index));
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+TfLiteStatus LitexFullyConnectedEval(TfLiteContext* context,
+                                     TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+
+#ifdef USE_TFLM_COMPRESSION
+  // Compressed weights are decompressed by the reference kernel.
+  if (GetMicroContext(context)->IsTensorCompressed(
+          node, kFullyConnectedWeightsTensor)) {
+    return Delegate(Register_FULLY_CONNECTED().invoke, context, node);
+  }
+#endif  // USE_TFLM_COMPRESSION
+
+  if (!IsAcceleratedInt8(input, filter)) {
+    return Delegate(Register_FULLY_CONNECTED().invoke, context, node);
+  }
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *(static_cast<const OpDataLitexFullyConnected*>(node->user_data));
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+  int32_t* acc = static_cast<int32_t*>(
+      context->GetScratchBuffer(context, data.acc_buffer_index));
+  TF_LITE_ENSURE(context, acc != nullptr);
+
+  EvalInt8Accelerated(
+      *static_cast<const OpDataFullyConnected*>(data.fully_connected), input,
+      filter, bias, output, acc);
+  return kTfLiteOk;
+}
+
+#endif  // CSR_ACCELERATOR_BASE
+
+}  // namespace
+
+TFLMRegistration Register_FULLY_CONNECTED_LITEX() {
+#ifdef CSR_ACCELERATOR_BASE
+  return tflite::micro::RegisterOp(LitexFullyConnectedInit,
+                                   LitexFullyConnectedPrepare,
+                                   LitexFullyConnectedEval);
+#else
+  return Register_FULLY_CONNECTED();
+#endif
+}
+
+}  // namespace tflite
@@ -0,0 +1,35 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+/*
+ * LiteX FullyConnected kernel backed by the dot-product accelerator
+ */
+
+#ifndef LITEX_FULLY_CONNECTED_H_
+#define LITEX_FULLY_CONNECTED_H_
+
+#include "tensorflow/lite/micro/kernels/fully_connected.h"
+
+namespace tflite {
+
+// Same behavior as Register_FULLY_CONNECTED(). int8 x int8 layers run their
+// accum_depth loop on the accelerator when the SoC has one
+// (CSR_ACCELERATOR_BASE); every other type, and builds without the block,
+// use the reference kernel.
+TFLMRegistration Register_FULLY_CONNECTED_LITEX();
+
+}  // namespace tflite
+
+#endif  // LITEX_FULLY_CONNECTED_H_
@@ -112,20 +112,21 @@ TFLMRegistration Register_CONV_2D_INT4();
 inline TFLMRegistration Register_CONV_2D_INT4() { return Register_CONV_2D(); }
 #endif  // defined(CMSIS_NN)
 
-#if defined(CMSIS_NN) || defined(XTENSA)
+#if defined(CMSIS_NN) || defined(XTENSA) || defined(RISCV32)
 // Returns a TFLMRegistration struct for kernel variant that only supports
 // int8 activations and int8 weights and uses the latency optimized
 // implementations.
 TFLMRegistration Register_CONV_2D_INT8();
+#else
+inline TFLMRegistration Register_CONV_2D_INT8() { return Register_CONV_2D(); }
+#endif  // defined(CMSIS_NN) || defined(XTENSA) || defined(RISCV32)
 
+#if defined(CMSIS_NN) || defined(XTENSA)
 // Returns a TFLMRegistration struct for kernel variant that only supports
 // int16 activations and int8 weights and uses the latency optimized
 // implementations.
 TFLMRegistration Register_CONV_2D_INT16();
-
 #else
-inline TFLMRegistration Register_CONV_2D_INT8() { return Register_CONV_2D(); }
-
 inline TFLMRegistration Register_CONV_2D_INT16() { return Register_CONV_2D(); }
 #endif  // defined(CMSIS_NN) || defined(XTENSA)
 
@@ -201,6 +201,8 @@ TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node) {
       context, node, params, input_width, input_height, filter_width,
       filter_height, output_width, output_height, input->type, data));
 
+#if !defined(RISCV32)
+  // riscv32/conv.cc requests it only for the layers that need it.
   if (filter->type == kTfLiteInt4) {
     int filter_size =
         RuntimeShape(filter->dims->size,
@@ -209,6 +211,7 @@ TfLiteStatus ConvPrepare(TfLiteContext* context, TfLiteNode* node) {
     context->RequestScratchBufferInArena(context, filter_size,
                                          &data->filter_buffer_index);
   }
+#endif  // !defined(RISCV32)
 
 #ifdef USE_TFLM_COMPRESSION
 
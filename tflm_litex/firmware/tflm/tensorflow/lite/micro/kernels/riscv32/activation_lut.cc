@@ -0,0 +1,193 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/riscv32/activation_lut.h"
+
+#include <algorithm>
+
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/logistic.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/tanh.h"
+
+namespace tflite {
+namespace {
+
+// kSigmoidInt16Lut[256 + k] = sigmoid_table_uint16[k] - 32768 and
+// kSigmoidInt16Lut[256 - k] = 32768 - sigmoid_table_uint16[k], i.e.
+// 2^16 * (sigmoid(k/24) - 1/2) for k in [-255, 255]; the entries at +/-256
+// repeat the ones at +/-255. Tanh uses it as is (tanh(x) = 2*sigmoid(2x) - 1)
+// and Logistic with a +32768 offset.
+const int16_t kSigmoidInt16Lut[513] = {
+    -32767, -32767, -32766, -32766, -32766, -32766, -32766, -32766, -32766,
+    -32766, -32766, -32766, -32765, -32765, -32765, -32765, -32765, -32765,
+    -32765, -32765, -32764, -32764, -32764, -32764, -32764, -32764, -32763,
+    -32763, -32763, -32763, -32763, -32762, -32762, -32762, -32762, -32761,
+    -32761, -32761, -32761, -32760, -32760, -32760, -32759, -32759, -32758,
+    -32758, -32758, -32757, -32757, -32756, -32756, -32755, -32755, -32754,
+    -32754, -32753, -32752, -32752, -32751, -32750, -32749, -32749, -32748,
+    -32747, -32746, -32745, -32744, -32743, -32742, -32741, -32740, -32739,
+    -32737, -32736, -32735, -32733, -32732, -32730, -32729, -32727, -32725,
+    -32723, -32721, -32720, -32717, -32715, -32713, -32711, -32708, -32706,
+    -32703, -32700, -32697, -32694, -32691, -32688, -32685, -32681, -32677,
+    -32674, -32670, -32665, -32661, -32657, -32652, -32647, -32642, -32636,
+    -32631, -32625, -32619, -32613, -32606, -32599, -32592, -32584, -32577,
+    -32569, -32560, -32551, -32542, -32533, -32523, -32512, -32501, -32490,
+    -32478, -32466, -32453, -32440, -32426, -32411, -32396, -32381, -32364,
+    -32347, -32329, -32311, -32292, -32271, -32251, -32229, -32206, -32182,
+    -32158, -32132, -32105, -32077, -32048, -32018, -31986, -31953, -31919,
+    -31884, -31846, -31808, -31768, -31726, -31682, -31637, -31589, -31540,
+    -31489, -31436, -31380, -31322, -31262, -31200, -31135, -31067, -30997,
+    -30923, -30847, -30768, -30686, -30600, -30511, -30418, -30322, -30222,
+    -30118, -30010, -29898, -29781, -29660, -29534, -29404, -29268, -29128,
+    -28982, -28831, -28673, -28511, -28342, -28167, -27985, -27797, -27602,
+    -27400, -27191, -26975, -26751, -26520, -26280, -26032, -25776, -25512,
+    -25239, -24956, -24665, -24365, -24055, -23735, -23406, -23066, -22717,
+    -22357, -21987, -21606, -21215, -20813, -20401, -19977, -19543, -19097,
+    -18641, -18174, -17696, -17207, -16707, -16196, -15675, -15143, -14601,
+    -14049, -13487, -12915, -12334, -11743, -11144, -10536, -9920, -9296, -8664,
+    -8026, -7381, -6730, -6073, -5412, -4745, -4075, -3401, -2725, -2045, -1365,
+    -683, 0, 683, 1365, 2045, 2725, 3401, 4075, 4745, 5412, 6073, 6730, 7381,
+    8026, 8664, 9296, 9920, 10536, 11144, 11743, 12334, 12915, 13487, 14049,
+    14601, 15143, 15675, 16196, 16707, 17207, 17696, 18174, 18641, 19097, 19543,
+    19977, 20401, 20813, 21215, 21606, 21987, 22357, 22717, 23066, 23406, 23735,
+    24055, 24365, 24665, 24956, 25239, 25512, 25776, 26032, 26280, 26520, 26751,
+    26975, 27191, 27400, 27602, 27797, 27985, 28167, 28342, 28511, 28673, 28831,
+    28982, 29128, 29268, 29404, 29534, 29660, 29781, 29898, 30010, 30118, 30222,
+    30322, 30418, 30511, 30600, 30686, 30768, 30847, 30923, 30997, 31067, 31135,
+    31200, 31262, 31322, 31380, 31436, 31489, 31540, 31589, 31637, 31682, 31726,
+    31768, 31808, 31846, 31884, 31919, 31953, 31986, 32018, 32048, 32077, 32105,
+    32132, 32158, 32182, 32206, 32229, 32251, 32271, 32292, 32311, 32329, 32347,
+    32364, 32381, 32396, 32411, 32426, 32440, 32453, 32466, 32478, 32490, 32501,
+    32512, 32523, 32533, 32542, 32551, 32560, 32569, 32577, 32584, 32592, 32599,
+    32606, 32613, 32619, 32625, 32631, 32636, 32642, 32647, 32652, 32657, 32661,
+    32665, 32670, 32674, 32677, 32681, 32685, 32688, 32691, 32694, 32697, 32700,
+    32703, 32706, 32708, 32711, 32713, 32715, 32717, 32720, 32721, 32723, 32725,
+    32727, 32729, 32730, 32732, 32733, 32735, 32736, 32737, 32739, 32740, 32741,
+    32742, 32743, 32744, 32745, 32746, 32747, 32748, 32749, 32749, 32750, 32751,
+    32752, 32752, 32753, 32754, 32754, 32755, 32755, 32756, 32756, 32757, 32757,
+    32758, 32758, 32758, 32759, 32759, 32760, 32760, 32760, 32761, 32761, 32761,
+    32761, 32762, 32762, 32762, 32762, 32763, 32763, 32763, 32763, 32763, 32764,
+    32764, 32764, 32764, 32764, 32764, 32765, 32765, 32765, 32765, 32765, 32765,
+    32765, 32765, 32766, 32766, 32766, 32766, 32766, 32766, 32766, 32766, 32766,
+    32766, 32767, 32767
+};
+
+constexpr int kSigmoidInt16LutCenter = 256;
+
+// Interpolates kSigmoidInt16Lut at x / 2^kFractionBits, x in
+// [-255 * 2^kFractionBits, 255 * 2^kFractionBits]. Equal to the reference
+// interpolation on |x| with the sign applied afterwards: for x < 0, the
+// segment below x interpolated upwards is the reference segment above |x|
+// interpolated downwards.
+template <int kFractionBits>
+inline int32_t Interpolate(int32_t x) {
+  const int16_t* point =
+      kSigmoidInt16Lut + kSigmoidInt16LutCenter + (x >> kFractionBits);
+  const int32_t fraction = x & ((1 << kFractionBits) - 1);
+  return point[0] * (1 << kFractionBits) + fraction * (point[1] - point[0]);
+}
+
+// The input rescaling of the int16 reference kernels.
+struct Int16InputScale {
+  Int16InputScale(int32_t input_multiplier, int32_t input_left_shift) {
+    if (input_multiplier == 0) {  // power of two case
+      input_multiplier = 3 << input_left_shift;
+      input_left_shift = 0;
+    }
+    multiplier = input_multiplier;
+    shift = input_left_shift;
+    round = shift > 0 ? 1 << (shift - 1) : 0;
+  }
+  int32_t operator()(int16_t x) const {
+    return (x * multiplier + round) >> shift;
+  }
+  int32_t multiplier, shift, round;
+};
+
+}  // namespace
+
+void LogisticInt8Lut(int32_t input_zero_point, int32_t input_range_radius,
+                     int32_t input_multiplier, int32_t input_left_shift,
+                     int8_t* lut) {
+  int8_t inputs[kActivationInt8LutSize];
+  for (int i = 0; i < kActivationInt8LutSize; ++i) {
+    inputs[i] = static_cast<int8_t>(i);
+  }
+  reference_integer_ops::Logistic(input_zero_point, input_range_radius,
+                                  input_multiplier, input_left_shift,
+                                  kActivationInt8LutSize, inputs, lut);
+}
+
+void TanhInt8Lut(int32_t input_zero_point, int32_t input_range_radius,
+                 int32_t input_multiplier, int32_t input_left_shift,
+                 int8_t* lut) {
+  int8_t inputs[kActivationInt8LutSize];
+  for (int i = 0; i < kActivationInt8LutSize; ++i) {
+    inputs[i] = static_cast<int8_t>(i);
+  }
+  const RuntimeShape shape(1, kActivationInt8LutSize);
+  reference_integer_ops::Tanh(input_zero_point, input_range_radius,
+                              input_multiplier, input_left_shift, shape,
+                              inputs, shape, lut);
+}
+
+void ActivationInt8Riscv32(const int8_t* lut, int size, const int8_t* input,
+                           int8_t* output) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const int8_t y0 = lut[in[i]];
+    const int8_t y1 = lut[in[i + 1]];
+    const int8_t y2 = lut[in[i + 2]];
+    const int8_t y3 = lut[in[i + 3]];
+    output[i] = y0;
+    output[i + 1] = y1;
+    output[i + 2] = y2;
+    output[i + 3] = y3;
+  }
+  for (; i < size; ++i) {
+    output[i] = lut[in[i]];
+  }
+}
+
+void LogisticInt16Riscv32(int32_t input_multiplier, int32_t input_left_shift,
+                          int size, const int16_t* input, int16_t* output) {
+  // Q9 segments. The reference output saturates (32767 or 1) from
+  // |x| = 255 * 2^9 - 1 on, where the last segment already reaches it.
+  constexpr int32_t kLimit = 255 * (1 << 9) - 1;
+  const Int16InputScale scale(input_multiplier, input_left_shift);
+  for (int i = 0; i < size; ++i) {
+    const int32_t x = std::min(std::max(scale(input[i]), -kLimit), kLimit);
+    // 32768 << 9 moves the table back to sigmoid_table_uint16, and the
+    // reference rounds with 512 for x >= 0 and 511 for x < 0.
+    const int32_t y = Interpolate<9>(x) + (32768 << 9) + (1 << 9) + (x >> 31);
+    output[i] = static_cast<int16_t>(y >> 10);
+  }
+}
+
+void TanhInt16Riscv32(int32_t input_multiplier, int32_t input_left_shift,
+                      int size, const int16_t* input, int16_t* output) {
+  // Q8 segments; the reference saturates from |x| = 255 * 2^8 on, at the
+  // last table point.
+  constexpr int32_t kLimit = 255 * (1 << 8);
+  const Int16InputScale scale(input_multiplier, input_left_shift);
+  for (int i = 0; i < size; ++i) {
+    const int32_t x = std::min(std::max(scale(input[i]), -kLimit), kLimit);
+    // The reference rounds with 128 for x >= 0 and 127 for x < 0.
+    const int32_t y = Interpolate<8>(x) + (1 << 7) + (x >> 31);
+    output[i] = static_cast<int16_t>(y >> 8);
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,62 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_ACTIVATION_LUT_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_ACTIVATION_LUT_H_
+
+#include <cstdint>
+
+namespace tflite {
+
+// Table-driven Logistic and Tanh for RV32IM, bit-exact with
+// reference_integer_ops::Logistic/Tanh.
+//
+// int8: the reference kernels run gemmlowp's fixed-point logistic/tanh (a
+// rational approximation with a Newton-Raphson division, a dozen 32x32->64
+// multiplications) per element. An int8 input takes only 256 values, so
+// Prepare evaluates the reference function once for each of them and Eval
+// is one table lookup per element.
+//
+// int16: the reference kernels interpolate in sigmoid_table_uint16 on |x|,
+// with sign and saturation branches. The same points mirrored and centered
+// on zero make a 513-entry table over [-256, 256] that is interpolated on
+// the signed input directly: a clamp, two loads and one multiplication per
+// element. That table does not depend on the quantization parameters, so
+// it is constant data (flash) instead of being built in Prepare.
+
+constexpr int kActivationInt8LutSize = 256;
+
+// Fill lut[(uint8_t)x] (kActivationInt8LutSize entries) with the reference
+// output for each int8 input x, from the parameters the reference Prepare
+// computes.
+void LogisticInt8Lut(int32_t input_zero_point, int32_t input_range_radius,
+                     int32_t input_multiplier, int32_t input_left_shift,
+                     int8_t* lut);
+void TanhInt8Lut(int32_t input_zero_point, int32_t input_range_radius,
+                 int32_t input_multiplier, int32_t input_left_shift,
+                 int8_t* lut);
+
+// output[i] = lut[(uint8_t)input[i]]. input and output may alias.
+void ActivationInt8Riscv32(const int8_t* lut, int size, const int8_t* input,
+                           int8_t* output);
+
+// Same arguments as the int16 reference kernels; input and output may alias.
+void LogisticInt16Riscv32(int32_t input_multiplier, int32_t input_left_shift,
+                          int size, const int16_t* input, int16_t* output);
+void TanhInt16Riscv32(int32_t input_multiplier, int32_t input_left_shift,
+                      int size, const int16_t* input, int16_t* output);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_ACTIVATION_LUT_H_
@@ -0,0 +1,152 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Host-side test: the table-driven Logistic/Tanh against
+// reference_integer_ops::Logistic/Tanh on every int8 and int16 input value,
+// for random quantization parameters.
+// Built and run by `make test` in the TFLM directory.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/logistic.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/tanh.h"
+#include "tensorflow/lite/micro/kernels/riscv32/activation_lut.h"
+#include "tensorflow/lite/micro/kernels/riscv32/test_util.h"
+
+namespace {
+
+using tflite::riscv32_test::Uniform;
+
+struct Params {
+  int32_t zero_point, range_radius, multiplier;
+  int left_shift;
+};
+
+// What the int8 Prepare of both kernels derives from the input scale.
+Params Int8Params(double scale, int32_t zero_point) {
+  constexpr int kInputIntegerBits = 4;
+  Params p;
+  p.zero_point = zero_point;
+  const double q =
+      std::frexp(scale * (1 << (31 - kInputIntegerBits)), &p.left_shift);
+  p.multiplier = static_cast<int32_t>(tflite::TfLiteRound(q * (1ll << 31)));
+  p.range_radius =
+      tflite::CalculateInputRadius(kInputIntegerBits, p.left_shift, 31);
+  return p;
+}
+
+// The int16 input rescaling: the power-of-two case (multiplier 0), the fixed
+// multiplier 3 of the LSTM kernel, or what Prepare derives from a general
+// input scale.
+Params Int16Params(std::mt19937& rng, bool tanh, int iteration) {
+  Params p = {};
+  switch (iteration % 3) {
+    case 0:
+      // Tanh also gets shifts above 1 from the LSTM cell state.
+      p.multiplier = 0;
+      p.left_shift = tanh ? Uniform(rng, 0, 4) : 0;
+      break;
+    case 1:
+      p.multiplier = 3;
+      p.left_shift = Uniform(rng, 0, 6);
+      break;
+    default: {
+      double multiplier = Uniform(rng, 1, 4000) / 1e6 * 4096.0 * 3.0;
+      p.left_shift = 0;
+      while (multiplier <= 32767.0 / 2.0 && p.left_shift <= 30) {
+        p.left_shift++;
+        multiplier *= 2.0;
+      }
+      p.multiplier = static_cast<int32_t>(multiplier);
+    }
+  }
+  return p;
+}
+
+// The >> FAIL prefix of a parameter set; output i is f(i - 128) for int8 and
+// f(i - 32768) for int16.
+void Describe(const char* name, const Params& p, char* what, size_t size) {
+  std::snprintf(what, size, "%s multiplier %d shift %d", name,
+                static_cast<int>(p.multiplier), p.left_shift);
+}
+
+int CheckInt8(std::mt19937& rng, bool tanh) {
+  const Params p =
+      Int8Params(Uniform(rng, 1, 1000) / 10000.0, Uniform(rng, -128, 127));
+  std::vector<int8_t> input(256), expected(256), actual(256);
+  for (int i = 0; i < 256; ++i) input[i] = static_cast<int8_t>(i - 128);
+  int8_t lut[tflite::kActivationInt8LutSize];
+  if (tanh) {
+    const tflite::RuntimeShape shape(1, 256);
+    tflite::reference_integer_ops::Tanh(p.zero_point, p.range_radius,
+                                        p.multiplier, p.left_shift, shape,
+                                        input.data(), shape, expected.data());
+    tflite::TanhInt8Lut(p.zero_point, p.range_radius, p.multiplier,
+                        p.left_shift, lut);
+  } else {
+    tflite::reference_integer_ops::Logistic(p.zero_point, p.range_radius,
+                                            p.multiplier, p.left_shift, 256,
+                                            input.data(), expected.data());
+    tflite::LogisticInt8Lut(p.zero_point, p.range_radius, p.multiplier,
+                            p.left_shift, lut);
+  }
+  tflite::ActivationInt8Riscv32(lut, 256, input.data(), actual.data());
+  char what[64];
+  Describe(tanh ? "int8 tanh" : "int8 logistic", p, what, sizeof(what));
+  return tflite::riscv32_test::CountMismatches(what, actual, expected);
+}
+
+int CheckInt16(std::mt19937& rng, bool tanh, int iteration) {
+  const Params p = Int16Params(rng, tanh, iteration);
+  std::vector<int16_t> input(65536), expected(65536), actual(65536);
+  for (int i = 0; i < 65536; ++i) input[i] = static_cast<int16_t>(i - 32768);
+  if (tanh) {
+    const tflite::RuntimeShape shape(1, 65536);
+    tflite::reference_integer_ops::Tanh(p.multiplier, p.left_shift, shape,
+                                        input.data(), shape, expected.data());
+    tflite::TanhInt16Riscv32(p.multiplier, p.left_shift, 65536, input.data(),
+                             actual.data());
+  } else {
+    tflite::reference_integer_ops::Logistic(p.multiplier, p.left_shift, 65536,
+                                            input.data(), expected.data());
+    tflite::LogisticInt16Riscv32(p.multiplier, p.left_shift, 65536,
+                                 input.data(), actual.data());
+  }
+  char what[64];
+  Describe(tanh ? "int16 tanh" : "int16 logistic", p, what, sizeof(what));
+  return tflite::riscv32_test::CountMismatches(what, actual, expected);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  // Cases alternate between int8 and int16, in pairs of the same function:
+  // two logistic, two tanh, and so on.
+  return tflite::riscv32_test::RunRandomCases(
+      argc, argv, 400, "parameter sets", [](std::mt19937& rng, int iteration) {
+        const int pair = iteration / 2;
+        const bool tanh = pair % 2 != 0;
+        if (iteration % 2 == 0) {
+          return tflite::riscv32_test::CaseResult{256, CheckInt8(rng, tanh)};
+        }
+        return tflite::riscv32_test::CaseResult{
+            65536, CheckInt16(rng, tanh, pair / 2)};
+      });
+}
@@ -0,0 +1,421 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Conv2D for RV32IM targets (OPTIMIZED_KERNEL_DIR=riscv32).
+//
+// Same as the reference kernel except for int8 layers with constant int8 or
+// int4 filters, no dilation and no groups, which run ConvInt8Riscv32() (or,
+// for int4 filters over the cache budget in int4_filter.h, ConvInt4Riscv32())
+// with the input offset folded into a per-channel bias computed once in
+// Prepare. ConvPrepare() leaves the int4 unpack buffer to this file, which
+// only requests it for int4 layers left to the reference kernel.
+
+#include "tensorflow/lite/micro/kernels/conv.h"
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/portable_tensor_utils.h"
+#include "tensorflow/lite/kernels/internal/reference/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/riscv32/conv_int8.h"
+#include "tensorflow/lite/micro/kernels/riscv32/int4_filter.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+struct OpDataConvRiscv32 {
+  // Must stay first: ConvPrepare() and the reference path use it as
+  // OpDataConv.
+  OpDataConv reference;
+  // Per-channel bias with the input offset folded in (persistent), or null
+  // when the int8 layer falls back to the reference kernel.
+  int32_t* effective_bias;
+  // int4 filter unpacked once in Prepare (persistent), or null when the
+  // int4 kernel reads the packed filter.
+  const int8_t* unpacked_filter;
+};
+
+void* ConvInitRiscv32(TfLiteContext* context, const char* buffer,
+                      size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context, sizeof(OpDataConvRiscv32));
+}
+
+TfLiteStatus ConvPrepareRiscv32(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_OK(context, ConvPrepare(context, node));
+
+  auto* data = static_cast<OpDataConvRiscv32*>(node->user_data);
+  data->effective_bias = nullptr;
+  data->unpacked_filter = nullptr;
+  const auto& params =
+      *(static_cast<const TfLiteConvParams*>(node->builtin_data));
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter =
+      micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  TfLiteTensor* bias =
+      micro_context->AllocateTempInputTensor(node, kConvBiasTensor);
+
+  // The effective bias needs the filter (and bias) values at Prepare time.
+  bool optimized =
+      input->type == kTfLiteInt8 &&
+      (filter->type == kTfLiteInt8 || filter->type == kTfLiteInt4) &&
+      IsConstantTensor(filter) && (bias == nullptr || IsConstantTensor(bias));
+#ifdef USE_TFLM_COMPRESSION
+  optimized = optimized &&
+              !micro_context->IsTensorCompressed(node, kConvWeightsTensor) &&
+              !micro_context->IsTensorCompressed(node, kConvBiasTensor);
+#endif  // USE_TFLM_COMPRESSION
+  const RuntimeShape filter_shape = GetTensorShape(filter);
+  optimized = optimized && ConvInt8Riscv32Supported(
+                               ConvParamsQuantized(params, data->reference),
+                               GetTensorShape(input), filter_shape);
+  if (optimized) {
+    const int output_depth = filter_shape.Dims(kConvQuantizedDimension);
+    const int filter_size = filter_shape.FlatSize() / output_depth;
+    data->effective_bias =
+        static_cast<int32_t*>(context->AllocatePersistentBuffer(
+            context, output_depth * sizeof(int32_t)));
+    TF_LITE_ENSURE(context, data->effective_bias != nullptr);
+    const int32_t* bias_data =
+        bias != nullptr ? GetTensorData<int32_t>(bias) : nullptr;
+    if (filter->type == kTfLiteInt4) {
+      data->unpacked_filter = riscv32::UnpackInt4FilterOnce(context, filter);
+    }
+    if (filter->type == kTfLiteInt4 && data->unpacked_filter == nullptr) {
+      ConvInt4EffectiveBias(GetTensorData<int8_t>(filter), bias_data,
+                            output_depth, filter_size,
+                            -data->reference.input_zero_point,
+                            data->effective_bias);
+    } else {
+      ConvInt8EffectiveBias(data->unpacked_filter != nullptr
+                                ? data->unpacked_filter
+                                : GetTensorData<int8_t>(filter),
+                            bias_data, output_depth, filter_size,
+                            -data->reference.input_zero_point,
+                            data->effective_bias);
+    }
+  } else if (filter->type == kTfLiteInt4) {
+    context->RequestScratchBufferInArena(context, filter_shape.FlatSize(),
+                                         &data->reference.filter_buffer_index);
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  if (bias != nullptr) {
+    micro_context->DeallocateTempTfLiteTensor(bias);
+  }
+  return kTfLiteOk;
+}
+
+// Returns true when the int8 layer ran on ConvInt8Riscv32() or
+// ConvInt4Riscv32().
+bool EvalInt8Riscv32(const TfLiteConvParams& params,
+                     const OpDataConvRiscv32& data,
+                     const TfLiteEvalTensor* input,
+                     const TfLiteEvalTensor* filter,
+                     TfLiteEvalTensor* output) {
+  if (data.effective_bias == nullptr) {
+    return false;
+  }
+  if (filter->type == kTfLiteInt4 && data.unpacked_filter == nullptr) {
+    ConvInt4Riscv32(ConvParamsQuantized(params, data.reference),
+                    data.reference.per_channel_output_multiplier,
+                    data.reference.per_channel_output_shift,
+                    data.effective_bias, tflite::micro::GetTensorShape(input),
+                    tflite::micro::GetTensorData<int8_t>(input),
+                    tflite::micro::GetTensorShape(filter),
+                    tflite::micro::GetTensorData<int8_t>(filter),
+                    tflite::micro::GetTensorShape(output),
+                    tflite::micro::GetTensorData<int8_t>(output));
+    return true;
+  }
+  ConvInt8Riscv32(ConvParamsQuantized(params, data.reference),
+                  data.reference.per_channel_output_multiplier,
+                  data.reference.per_channel_output_shift,
+                  data.effective_bias, tflite::micro::GetTensorShape(input),
+                  tflite::micro::GetTensorData<int8_t>(input),
+                  tflite::micro::GetTensorShape(filter),
+                  data.unpacked_filter != nullptr
+                      ? data.unpacked_filter
+                      : tflite::micro::GetTensorData<int8_t>(filter),
+                  tflite::micro::GetTensorShape(output),
+                  tflite::micro::GetTensorData<int8_t>(output));
+  return true;
+}
+
+TfLiteStatus ConvEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data_riscv32 =
+      *(static_cast<const OpDataConvRiscv32*>(node->user_data));
+  const auto& data = data_riscv32.reference;
+
+#ifdef USE_TFLM_COMPRESSION
+
+  MicroContext* micro_context = GetMicroContext(context);
+
+  const CompressionTensorData* weights_comp_td =
+      micro_context->GetTensorCompressionData(node, kConvWeightsTensor);
+  const CompressionTensorData* bias_comp_td =
+      micro_context->GetTensorCompressionData(node, kConvBiasTensor);
+
+#endif  // USE_TFLM_COMPRESSION
+
+  switch (input->type) {  // Already know in/out types are same.
+    case kTfLiteFloat32: {
+      tflite::reference_ops::Conv(
+          ConvParamsFloat(params, data), tflite::micro::GetTensorShape(input),
+          tflite::micro::GetTensorData<float>(input),
+          tflite::micro::GetTensorShape(filter),
+#ifdef USE_TFLM_COMPRESSION
+          tflite::micro::GetTensorData<float>(micro_context, filter,
+                                              weights_comp_td,
+                                              data.weights_scratch_index),
+          tflite::micro::GetTensorShape(bias),
+          tflite::micro::GetOptionalTensorData<float>(
+              micro_context, bias, bias_comp_td, data.bias_scratch_index),
+#else   // USE_TFLM_COMPRESSION
+          tflite::micro::GetTensorData<float>(filter),
+          tflite::micro::GetTensorShape(bias),
+          tflite::micro::GetOptionalTensorData<float>(bias),
+#endif  // USE_TFLM_COMPRESSION
+          tflite::micro::GetTensorShape(output),
+          tflite::micro::GetTensorData<float>(output),
+          tflite::micro::GetTensorShape(nullptr), nullptr);
+      break;
+    }
+    case kTfLiteInt16: {
+      if (bias == nullptr || bias->type == kTfLiteInt32) {
+        reference_integer_ops::ConvPerChannel(
+            ConvParamsQuantized(params, data),
+            data.per_channel_output_multiplier, data.per_channel_output_shift,
+            tflite::micro::GetTensorShape(input),
+            tflite::micro::GetTensorData<int16_t>(input),
+            tflite::micro::GetTensorShape(filter),
+#ifdef USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorData<int8_t>(micro_context, filter,
+                                                 weights_comp_td,
+                                                 data.weights_scratch_index),
+            tflite::micro::GetTensorShape(bias),
+            tflite::micro::GetOptionalTensorData<int32_t>(
+                micro_context, bias, bias_comp_td, data.bias_scratch_index),
+#else   // USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorData<int8_t>(filter),
+            tflite::micro::GetTensorShape(bias),
+            tflite::micro::GetOptionalTensorData<std::int32_t>(bias),
+#endif  // USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorShape(output),
+            tflite::micro::GetTensorData<int16_t>(output));
+      } else if (bias->type == kTfLiteInt64) {
+        reference_integer_ops::ConvPerChannel(
+            ConvParamsQuantized(params, data),
+            data.per_channel_output_multiplier, data.per_channel_output_shift,
+            tflite::micro::GetTensorShape(input),
+            tflite::micro::GetTensorData<int16_t>(input),
+            tflite::micro::GetTensorShape(filter),
+#ifdef USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorData<int8_t>(micro_context, filter,
+                                                 weights_comp_td,
+                                                 data.weights_scratch_index),
+            tflite::micro::GetTensorShape(bias),
+            tflite::micro::GetTensorData<int64_t>(
+                micro_context, bias, bias_comp_td, data.bias_scratch_index),
+#else   // USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorData<int8_t>(filter),
+            tflite::micro::GetTensorShape(bias),
+            tflite::micro::GetTensorData<std::int64_t>(bias),
+#endif  // USE_TFLM_COMPRESSION
+            tflite::micro::GetTensorShape(output),
+            tflite::micro::GetTensorData<int16_t>(output));
+      } else {
+        MicroPrintf("Bias type %s (%d) not supported.",
+                    TfLiteTypeGetName(bias->type), bias->type);
+        return kTfLiteError;
+      }
+      break;
+    }
+    case kTfLiteInt8: {
+      switch (filter->type) {
+        case kTfLiteInt4: {
+          if (EvalInt8Riscv32(params, data_riscv32, input, filter, output)) {
+            break;
+          }
+          int8_t* unpacked_filter_data = static_cast<int8_t*>(
+              context->GetScratchBuffer(context, data.filter_buffer_index));
+          tflite::tensor_utils::UnpackDenseInt4IntoInt8(
+              tflite::micro::GetTensorData<int8_t>(filter),
+              tflite::micro::GetTensorShape(filter).FlatSize(),
+              unpacked_filter_data);
+          reference_integer_ops::ConvPerChannel(
+              ConvParamsQuantized(params, data),
+              data.per_channel_output_multiplier, data.per_channel_output_shift,
+              tflite::micro::GetTensorShape(input),
+              tflite::micro::GetTensorData<int8_t>(input),
+              tflite::micro::GetTensorShape(filter), unpacked_filter_data,
+              tflite::micro::GetTensorShape(bias),
+              tflite::micro::GetOptionalTensorData<int32_t>(bias),
+              tflite::micro::GetTensorShape(output),
+              tflite::micro::GetTensorData<int8_t>(output));
+          break;
+        }
+        case kTfLiteInt8: {
+          if (EvalInt8Riscv32(params, data_riscv32, input, filter, output)) {
+            break;
+          }
+          reference_integer_ops::ConvPerChannel(
+              ConvParamsQuantized(params, data),
+              data.per_channel_output_multiplier, data.per_channel_output_shift,
+              tflite::micro::GetTensorShape(input),
+              tflite::micro::GetTensorData<int8_t>(input),
+              tflite::micro::GetTensorShape(filter),
+#ifdef USE_TFLM_COMPRESSION
+              tflite::micro::GetTensorData<int8_t>(micro_context, filter,
+                                                   weights_comp_td,
+                                                   data.weights_scratch_index),
+              tflite::micro::GetTensorShape(bias),
+              tflite::micro::GetOptionalTensorData<int32_t>(
+                  micro_context, bias, bias_comp_td, data.bias_scratch_index),
+#else   // USE_TFLM_COMPRESSION
+              tflite::micro::GetTensorData<int8_t>(filter),
+              tflite::micro::GetTensorShape(bias),
+              tflite::micro::GetOptionalTensorData<int32_t>(bias),
+#endif  // USE_TFLM_COMPRESSION
+              tflite::micro::GetTensorShape(output),
+              tflite::micro::GetTensorData<int8_t>(output));
+          break;
+        }
+        default:
+          MicroPrintf("Weight type %s (%d) not supported.",
+                      TfLiteTypeGetName(filter->type), filter->type);
+          return kTfLiteError;
+      }
+      break;
+    }
+    default:
+      MicroPrintf("Type %s (%d) not supported.", TfLiteTypeGetName(input->type),
+                  input->type);
+      return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+// Register_CONV_2D_INT8(): int8 activations and int8 weights only, so the
+// float and int16 reference kernels are not linked in.
+TfLiteStatus ConvPrepareInt8(TfLiteContext* context, TfLiteNode* node) {
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter =
+      micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  const bool int8 =
+      input->type == kTfLiteInt8 && filter->type == kTfLiteInt8;
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  TF_LITE_ENSURE_MSG(context, int8,
+                     "CONV_2D_INT8 supports int8 input and filter only.");
+  return ConvPrepareRiscv32(context, node);
+}
+
+TfLiteStatus ConvEvalInt8(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data_riscv32 =
+      *(static_cast<const OpDataConvRiscv32*>(node->user_data));
+  const auto& data = data_riscv32.reference;
+
+  if (EvalInt8Riscv32(params, data_riscv32, input, filter, output)) {
+    return kTfLiteOk;
+  }
+
+#ifdef USE_TFLM_COMPRESSION
+  MicroContext* micro_context = GetMicroContext(context);
+  const CompressionTensorData* weights_comp_td =
+      micro_context->GetTensorCompressionData(node, kConvWeightsTensor);
+  const CompressionTensorData* bias_comp_td =
+      micro_context->GetTensorCompressionData(node, kConvBiasTensor);
+#endif  // USE_TFLM_COMPRESSION
+
+  reference_integer_ops::ConvPerChannel(
+      ConvParamsQuantized(params, data), data.per_channel_output_multiplier,
+      data.per_channel_output_shift, tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<int8_t>(input),
+      tflite::micro::GetTensorShape(filter),
+#ifdef USE_TFLM_COMPRESSION
+      tflite::micro::GetTensorData<int8_t>(micro_context, filter,
+                                           weights_comp_td,
+                                           data.weights_scratch_index),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<int32_t>(
+          micro_context, bias, bias_comp_td, data.bias_scratch_index),
+#else   // USE_TFLM_COMPRESSION
+      tflite::micro::GetTensorData<int8_t>(filter),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<int32_t>(bias),
+#endif  // USE_TFLM_COMPRESSION
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<int8_t>(output));
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration Register_CONV_2D() {
+  return tflite::micro::RegisterOp(ConvInitRiscv32, ConvPrepareRiscv32,
+                                   ConvEval);
+}
+
+TFLMRegistration Register_CONV_2D_INT8() {
+  return tflite::micro::RegisterOp(ConvInitRiscv32, ConvPrepareInt8,
+                                   ConvEvalInt8);
+}
+
+}  // namespace tflite
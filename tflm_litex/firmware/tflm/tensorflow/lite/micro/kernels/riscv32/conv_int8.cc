@@ -0,0 +1,281 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/riscv32/conv_int8.h"
+
+#include <algorithm>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/micro/kernels/riscv32/mac_tile.h"
+
+namespace tflite {
+namespace {
+
+using riscv32::ClearTile;
+using riscv32::Int8Filter;
+using riscv32::PackedInt4Filter;
+
+struct ConvGeometry {
+  int input_height, input_width, input_depth;
+  int filter_height, filter_width;
+  int output_height, output_width, output_depth;
+  int stride_height, stride_width;
+  int pad_height, pad_width;
+  // filter_width * input_depth: one filter row, contiguous in the filter
+  // and (without dilation) in the input.
+  int row_len;
+  // filter_height * row_len: distance between output channels' filters.
+  int filter_size;
+};
+
+struct Requantizer {
+  const ConvParams& params;
+  const int32_t* output_multiplier;
+  const int32_t* output_shift;
+
+  int8_t operator()(uint32_t acc, int out_c) const {
+    int32_t acc_scaled = MultiplyByQuantizedMultiplier(
+        static_cast<int32_t>(acc), output_multiplier[out_c],
+        output_shift[out_c]);
+    acc_scaled += params.output_offset;
+    acc_scaled = std::max(acc_scaled, params.quantized_activation_min);
+    acc_scaled = std::min(acc_scaled, params.quantized_activation_max);
+    return static_cast<int8_t>(acc_scaled);
+  }
+};
+
+// kPixels adjacent interior pixels x kChannels output channels from out_c.
+// input points to the top-left tap of the first pixel, output to its
+// channel 0.
+template <typename Filter, int kPixels, int kChannels>
+inline void InteriorTile(const ConvGeometry& g, const Requantizer& requantize,
+                         const int32_t* effective_bias, const int8_t* input,
+                         const int8_t* filter, int out_c, int8_t* output) {
+  uint32_t acc[kPixels][kChannels];
+  ClearTile<kPixels, kChannels>(acc);
+  const int input_row_stride = g.input_width * g.input_depth;
+  const int pixel_stride = g.stride_width * g.input_depth;
+  for (int ky = 0; ky < g.filter_height; ++ky) {
+    Filter::template Mac<kPixels, kChannels>(
+        input + ky * input_row_stride, pixel_stride, filter,
+        out_c * g.filter_size + ky * g.row_len, g.filter_size, g.row_len, acc);
+  }
+  for (int p = 0; p < kPixels; ++p) {
+    for (int c = 0; c < kChannels; ++c) {
+      output[p * g.output_depth + out_c + c] = requantize(
+          acc[p][c] + static_cast<uint32_t>(effective_bias[out_c + c]),
+          out_c + c);
+    }
+  }
+}
+
+// All output channels of kPixels interior pixels: 4-channel blocks, then the
+// rest.
+template <typename Filter, int kPixels>
+inline void InteriorPixels(const ConvGeometry& g, const Requantizer& requantize,
+                           const int32_t* effective_bias, const int8_t* input,
+                           const int8_t* filter, int8_t* output) {
+  int out_c = 0;
+  if (Filter::CanTile(g.filter_size)) {
+    for (; out_c + 4 <= g.output_depth; out_c += 4) {
+      InteriorTile<Filter, kPixels, 4>(g, requantize, effective_bias, input,
+                                       filter, out_c, output);
+    }
+  }
+  for (; out_c < g.output_depth; ++out_c) {
+    InteriorTile<Filter, kPixels, 1>(g, requantize, effective_bias, input,
+                                     filter, out_c, output);
+  }
+}
+
+// One pixel whose receptive field crosses the padding. Taps inside the image
+// accumulate filter * input as in the interior; taps in the padding
+// accumulate (-input_offset) * filter, removing their share of
+// input_offset * sum(filter) from the effective bias.
+template <typename Filter>
+void EdgePixel(const ConvGeometry& g, const Requantizer& requantize,
+               const int32_t* effective_bias, int32_t input_offset,
+               const int8_t* input_batch, int in_y_origin, int in_x_origin,
+               const int8_t* filter, int8_t* output) {
+  for (int out_c = 0; out_c < g.output_depth; ++out_c) {
+    uint32_t acc[1][1] = {{0}};
+    uint32_t padded_sum = 0;
+    for (int ky = 0; ky < g.filter_height; ++ky) {
+      const int in_y = in_y_origin + ky;
+      const int filter_row = out_c * g.filter_size + ky * g.row_len;
+      if (in_y < 0 || in_y >= g.input_height) {
+        padded_sum += Filter::Sum(filter, filter_row, g.row_len);
+        continue;
+      }
+      for (int kx = 0; kx < g.filter_width; ++kx) {
+        const int in_x = in_x_origin + kx;
+        const int filter_tap = filter_row + kx * g.input_depth;
+        if (in_x < 0 || in_x >= g.input_width) {
+          padded_sum += Filter::Sum(filter, filter_tap, g.input_depth);
+          continue;
+        }
+        Filter::template Mac<1, 1>(
+            input_batch + (in_y * g.input_width + in_x) * g.input_depth, 0,
+            filter, filter_tap, 0, g.input_depth, acc);
+      }
+    }
+    output[out_c] = requantize(
+        acc[0][0] + static_cast<uint32_t>(effective_bias[out_c]) -
+            static_cast<uint32_t>(input_offset) * padded_sum,
+        out_c);
+  }
+}
+
+template <typename Filter>
+void EffectiveBias(const int8_t* filter, const int32_t* bias,
+                   int output_depth, int filter_size, int32_t input_offset,
+                   int32_t* effective_bias) {
+  for (int out_c = 0; out_c < output_depth; ++out_c) {
+    uint32_t value =
+        static_cast<uint32_t>(input_offset) *
+        Filter::Sum(filter, out_c * filter_size, filter_size);
+    if (bias) {
+      value += static_cast<uint32_t>(bias[out_c]);
+    }
+    effective_bias[out_c] = static_cast<int32_t>(value);
+  }
+}
+
+template <typename Filter>
+void Conv(const ConvParams& params, const int32_t* output_multiplier,
+          const int32_t* output_shift, const int32_t* effective_bias,
+          const RuntimeShape& input_shape, const int8_t* input_data,
+          const RuntimeShape& filter_shape, const int8_t* filter_data,
+          const RuntimeShape& output_shape, int8_t* output_data) {
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK(ConvInt8Riscv32Supported(params, input_shape, filter_shape));
+
+  ConvGeometry g;
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  g.input_height = input_shape.Dims(1);
+  g.input_width = input_shape.Dims(2);
+  g.input_depth = input_shape.Dims(3);
+  g.filter_height = filter_shape.Dims(1);
+  g.filter_width = filter_shape.Dims(2);
+  g.output_height = output_shape.Dims(1);
+  g.output_width = output_shape.Dims(2);
+  g.output_depth = MatchingDim(filter_shape, 0, output_shape, 3);
+  g.stride_height = params.stride_height;
+  g.stride_width = params.stride_width;
+  g.pad_height = params.padding_values.height;
+  g.pad_width = params.padding_values.width;
+  g.row_len = g.filter_width * g.input_depth;
+  g.filter_size = g.filter_height * g.row_len;
+
+  const Requantizer requantize{params, output_multiplier, output_shift};
+
+  int y_begin, y_end, x_begin, x_end;
+  ConvInteriorRange(g.input_height, g.filter_height, g.stride_height,
+                    g.pad_height, g.output_height, &y_begin, &y_end);
+  ConvInteriorRange(g.input_width, g.filter_width, g.stride_width,
+                    g.pad_width, g.output_width, &x_begin, &x_end);
+
+  const int input_batch_size = g.input_height * g.input_width * g.input_depth;
+  for (int b = 0; b < batches; ++b) {
+    const int8_t* input_batch = input_data + b * input_batch_size;
+    for (int out_y = 0; out_y < g.output_height; ++out_y) {
+      const int in_y_origin = out_y * g.stride_height - g.pad_height;
+      const bool interior_row = out_y >= y_begin && out_y < y_end;
+      int8_t* output_row =
+          output_data +
+          ((b * g.output_height + out_y) * g.output_width) * g.output_depth;
+      int out_x = 0;
+      while (out_x < g.output_width) {
+        const int in_x_origin = out_x * g.stride_width - g.pad_width;
+        int8_t* output_pixel = output_row + out_x * g.output_depth;
+        if (!interior_row || out_x < x_begin || out_x >= x_end) {
+          EdgePixel<Filter>(g, requantize, effective_bias, params.input_offset,
+                            input_batch, in_y_origin, in_x_origin, filter_data,
+                            output_pixel);
+          out_x += 1;
+          continue;
+        }
+        const int8_t* input_pixel =
+            input_batch +
+            (in_y_origin * g.input_width + in_x_origin) * g.input_depth;
+        if (out_x + 2 <= x_end) {
+          InteriorPixels<Filter, 2>(g, requantize, effective_bias,
+                                    input_pixel, filter_data, output_pixel);
+          out_x += 2;
+        } else {
+          InteriorPixels<Filter, 1>(g, requantize, effective_bias,
+                                    input_pixel, filter_data, output_pixel);
+          out_x += 1;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void ConvInt8EffectiveBias(const int8_t* filter, const int32_t* bias,
+                           int output_depth, int filter_size,
+                           int32_t input_offset, int32_t* effective_bias) {
+  EffectiveBias<Int8Filter>(filter, bias, output_depth, filter_size,
+                            input_offset, effective_bias);
+}
+
+bool ConvInt8Riscv32Supported(const ConvParams& params,
+                              const RuntimeShape& input_shape,
+                              const RuntimeShape& filter_shape) {
+  return params.dilation_width_factor == 1 &&
+         params.dilation_height_factor == 1 &&
+         input_shape.Dims(3) == filter_shape.Dims(3);
+}
+
+void ConvInt8Riscv32(const ConvParams& params,
+                     const int32_t* output_multiplier,
+                     const int32_t* output_shift,
+                     const int32_t* effective_bias,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& filter_shape,
+                     const int8_t* filter_data,
+                     const RuntimeShape& output_shape, int8_t* output_data) {
+  Conv<Int8Filter>(params, output_multiplier, output_shift, effective_bias,
+                   input_shape, input_data, filter_shape, filter_data,
+                   output_shape, output_data);
+}
+
+void ConvInt4EffectiveBias(const int8_t* packed_filter, const int32_t* bias,
+                           int output_depth, int filter_size,
+                           int32_t input_offset, int32_t* effective_bias) {
+  EffectiveBias<PackedInt4Filter>(packed_filter, bias, output_depth,
+                                  filter_size, input_offset, effective_bias);
+}
+
+void ConvInt4Riscv32(const ConvParams& params,
+                     const int32_t* output_multiplier,
+                     const int32_t* output_shift,
+                     const int32_t* effective_bias,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& filter_shape,
+                     const int8_t* packed_filter_data,
+                     const RuntimeShape& output_shape, int8_t* output_data) {
+  Conv<PackedInt4Filter>(params, output_multiplier, output_shift,
+                         effective_bias, input_shape, input_data, filter_shape,
+                         packed_filter_data, output_shape, output_data);
+}
+
+}  // namespace tflite
@@ -0,0 +1,97 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_CONV_INT8_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_CONV_INT8_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// int8 x int8 per-channel Conv2D for RV32IM, bit-exact with
+// reference_integer_ops::ConvPerChannel.
+//
+// The reference kernel checks the image bounds for every filter tap and
+// adds input_offset to every input value. Here:
+//  - input_offset * sum(filter[c]) and the bias are folded into a
+//    per-channel effective bias at Prepare time, leaving only
+//    filter * input in the inner loop;
+//  - output pixels whose receptive field lies inside the image (the
+//    interior) run without bounds checks. With no dilation each filter row
+//    and the input under it are contiguous (filter_width * input_depth
+//    values), so a row is a single dot product;
+//  - interior pixels are computed in tiles of 2 pixels x 4 output channels;
+//  - edge pixels add (-input_offset) * filter for the taps in the padding,
+//    which cancels their share of the effective bias (the reference kernel
+//    skips those taps).
+// All sums are taken modulo 2^32, like the reference kernel's int32
+// accumulator.
+
+// Fills effective_bias[0, output_depth) with
+// bias[c] + input_offset * sum(filter[c]). bias may be null.
+void ConvInt8EffectiveBias(const int8_t* filter, const int32_t* bias,
+                           int output_depth, int filter_size,
+                           int32_t input_offset, int32_t* effective_bias);
+
+// True when ConvInt8Riscv32() handles the layer: no dilation and no
+// grouped convolution (filter depth == input depth).
+bool ConvInt8Riscv32Supported(const ConvParams& params,
+                              const RuntimeShape& input_shape,
+                              const RuntimeShape& filter_shape);
+
+// [begin, end) of the output positions along one axis (no dilation) whose
+// filter taps all fall inside [0, input_size): the interior, computed
+// without bounds checks. Also used by the depthwise kernels.
+inline void ConvInteriorRange(int input_size, int filter_size, int stride,
+                              int pad, int output_size, int* begin, int* end) {
+  *begin = std::min(output_size, (pad + stride - 1) / stride);
+  const int last_origin = input_size + pad - filter_size;
+  *end = last_origin < 0 ? *begin
+                         : std::max(*begin, std::min(output_size,
+                                                     last_origin / stride + 1));
+}
+
+// Eval with the effective bias from ConvInt8EffectiveBias().
+void ConvInt8Riscv32(const ConvParams& params,
+                     const int32_t* output_multiplier,
+                     const int32_t* output_shift,
+                     const int32_t* effective_bias,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& filter_shape,
+                     const int8_t* filter_data,
+                     const RuntimeShape& output_shape, int8_t* output_data);
+
+// The same with packed int4 weights (kTfLiteInt4: two per byte, low nibble
+// first), read directly in the MAC loop instead of being unpacked into an
+// int8 copy. Same layers as ConvInt8Riscv32Supported(); with an odd
+// filter_size output channels are computed one at a time.
+void ConvInt4EffectiveBias(const int8_t* packed_filter, const int32_t* bias,
+                           int output_depth, int filter_size,
+                           int32_t input_offset, int32_t* effective_bias);
+
+void ConvInt4Riscv32(const ConvParams& params,
+                     const int32_t* output_multiplier,
+                     const int32_t* output_shift,
+                     const int32_t* effective_bias,
+                     const RuntimeShape& input_shape, const int8_t* input_data,
+                     const RuntimeShape& filter_shape,
+                     const int8_t* packed_filter_data,
+                     const RuntimeShape& output_shape, int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_CONV_INT8_H_
@@ -0,0 +1,153 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Host-side test: ConvInt8Riscv32() and ConvInt4Riscv32() against
+// reference_integer_ops::ConvPerChannel on random layers.
+// Built and run by `make test` in the TFLM directory.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
+#include "tensorflow/lite/micro/kernels/riscv32/conv_int8.h"
+#include "tensorflow/lite/micro/kernels/riscv32/test_util.h"
+
+namespace {
+
+using tflite::riscv32_test::Uniform;
+
+struct Layer : tflite::riscv32_test::LayerData {
+  int batches, input_height, input_width, input_depth;
+  int filter_height, filter_width, output_depth;
+  int output_height, output_width;
+  tflite::ConvParams params;
+};
+
+Layer RandomLayer(std::mt19937& rng, int iteration) {
+  Layer l;
+  l.params = tflite::ConvParams();
+  // Mostly 3x3 filters; images small enough that every pixel class (corner,
+  // edge, interior, odd interior pixel) shows up.
+  l.filter_height = iteration % 4 == 0 ? Uniform(rng, 1, 5) : 3;
+  l.filter_width = iteration % 4 == 0 ? Uniform(rng, 1, 5) : 3;
+  l.params.stride_height = Uniform(rng, 1, 3);
+  l.params.stride_width = Uniform(rng, 1, 3);
+  l.params.dilation_height_factor = 1;
+  l.params.dilation_width_factor = 1;
+  l.params.padding_values.height = Uniform(rng, 0, l.filter_height - 1);
+  l.params.padding_values.width = Uniform(rng, 0, l.filter_width - 1);
+  l.batches = Uniform(rng, 1, 2);
+  l.input_height = Uniform(rng, 1, 10);
+  l.input_width = Uniform(rng, 1, 10);
+  l.input_depth = Uniform(rng, 1, iteration % 8 == 1 ? 40 : 9);
+  l.output_depth = Uniform(rng, 1, iteration % 8 == 2 ? 33 : 9);
+  l.output_height = (l.input_height + 2 * l.params.padding_values.height -
+                     l.filter_height) /
+                        l.params.stride_height +
+                    1;
+  l.output_width = (l.input_width + 2 * l.params.padding_values.width -
+                    l.filter_width) /
+                       l.params.stride_width +
+                   1;
+  l.with_bias = iteration % 5 != 0;
+  l.int4 = iteration % 3 == 1;
+
+  l.params.input_offset = Uniform(rng, -127, 128);
+  l.params.output_offset = Uniform(rng, -128, 127);
+  tflite::riscv32_test::RandomActivationRange(
+      rng, iteration, &l.params.quantized_activation_min,
+      &l.params.quantized_activation_max);
+
+  l.input.resize(l.batches * l.input_height * l.input_width * l.input_depth);
+  for (auto& v : l.input) v = Uniform(rng, -128, 127);
+  l.filter.resize(l.output_depth * l.filter_height * l.filter_width *
+                  l.input_depth);
+  for (auto& v : l.filter) {
+    v = l.int4 ? Uniform(rng, -8, 7) : Uniform(rng, -127, 127);
+  }
+  if (l.int4) l.packed_filter = tflite::riscv32_test::PackInt4(l.filter);
+  tflite::riscv32_test::RandomChannelParams(rng, l.output_depth, &l);
+  return l;
+}
+
+int CheckLayer(const Layer& l) {
+  const int32_t input_dims[] = {l.batches, l.input_height, l.input_width,
+                                l.input_depth};
+  const int32_t filter_dims[] = {l.output_depth, l.filter_height,
+                                 l.filter_width, l.input_depth};
+  const int32_t output_dims[] = {l.batches, l.output_height, l.output_width,
+                                 l.output_depth};
+  const tflite::RuntimeShape input_shape(4, input_dims);
+  const tflite::RuntimeShape filter_shape(4, filter_dims);
+  const tflite::RuntimeShape bias_shape(1, &l.output_depth);
+  const tflite::RuntimeShape output_shape(4, output_dims);
+  const int32_t* bias = l.with_bias ? l.bias.data() : nullptr;
+
+  std::vector<int8_t> expected(output_shape.FlatSize());
+  std::vector<int8_t> actual(expected.size());
+  std::vector<int32_t> effective_bias(l.output_depth);
+
+  tflite::reference_integer_ops::ConvPerChannel(
+      l.params, l.multiplier.data(), l.shift.data(), input_shape,
+      l.input.data(), filter_shape, l.filter.data(), bias_shape, bias,
+      output_shape, expected.data());
+
+  const int filter_size = filter_shape.FlatSize() / l.output_depth;
+  if (l.int4) {
+    tflite::ConvInt4EffectiveBias(l.packed_filter.data(), bias,
+                                  l.output_depth, filter_size,
+                                  l.params.input_offset, effective_bias.data());
+    tflite::ConvInt4Riscv32(l.params, l.multiplier.data(), l.shift.data(),
+                            effective_bias.data(), input_shape, l.input.data(),
+                            filter_shape, l.packed_filter.data(), output_shape,
+                            actual.data());
+  } else {
+    tflite::ConvInt8EffectiveBias(l.filter.data(), bias, l.output_depth,
+                                  filter_size, l.params.input_offset,
+                                  effective_bias.data());
+    tflite::ConvInt8Riscv32(l.params, l.multiplier.data(), l.shift.data(),
+                            effective_bias.data(), input_shape, l.input.data(),
+                            filter_shape, l.filter.data(), output_shape,
+                            actual.data());
+  }
+
+  char what[96];
+  std::snprintf(what, sizeof(what),
+                "%s in %dx%dx%d filter %dx%d stride %d,%d pad %d,%d",
+                l.int4 ? "int4" : "int8", l.input_height, l.input_width,
+                l.input_depth, l.filter_height, l.filter_width,
+                l.params.stride_height, l.params.stride_width,
+                l.params.padding_values.height, l.params.padding_values.width);
+  return tflite::riscv32_test::CountMismatches(what, actual, expected);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return tflite::riscv32_test::RunRandomCases(
+      argc, argv, 2000, "layers", [](std::mt19937& rng, int iteration) {
+        const Layer layer = RandomLayer(rng, iteration);
+        // Padding can leave no output pixel; such layers are skipped.
+        if (layer.output_height < 1 || layer.output_width < 1) {
+          return tflite::riscv32_test::CaseResult{0, 0};
+        }
+        return tflite::riscv32_test::CaseResult{
+            static_cast<long>(layer.batches) * layer.output_height *
+                layer.output_width * layer.output_depth,
+            CheckLayer(layer)};
+      });
+}
@@ -0,0 +1,216 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/riscv32/depthwise_conv_int8.h"
+
+#include <algorithm>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/micro/kernels/riscv32/conv_int8.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kFilterSize = 3;
+constexpr int kFilterTaps = kFilterSize * kFilterSize;
+
+struct DepthwiseGeometry {
+  int input_height, input_width, depth;
+  int output_height, output_width;
+  int pad_height, pad_width;
+};
+
+struct Requantizer {
+  const DepthwiseParams& params;
+  const int32_t* output_multiplier;
+  const int32_t* output_shift;
+
+  int8_t operator()(uint32_t acc, int channel) const {
+    int32_t acc_scaled = MultiplyByQuantizedMultiplier(
+        static_cast<int32_t>(acc), output_multiplier[channel],
+        output_shift[channel]);
+    acc_scaled += params.output_offset;
+    acc_scaled = std::max(acc_scaled, params.quantized_activation_min);
+    acc_scaled = std::min(acc_scaled, params.quantized_activation_max);
+    return static_cast<int8_t>(acc_scaled);
+  }
+};
+
+// One pixel whose 3x3 window crosses the padding, all channels. Taps in the
+// padding accumulate (-input_offset) * filter, removing their share of the
+// effective bias.
+void EdgePixel(const DepthwiseGeometry& g, const Requantizer& requantize,
+               const int32_t* effective_bias, int32_t input_offset,
+               const int8_t* input_batch, int in_y_origin, int in_x_origin,
+               const int8_t* filter, int8_t* output) {
+  for (int c = 0; c < g.depth; ++c) {
+    uint32_t acc = static_cast<uint32_t>(effective_bias[c]);
+    uint32_t padded_sum = 0;
+    for (int ky = 0; ky < kFilterSize; ++ky) {
+      const int in_y = in_y_origin + ky;
+      for (int kx = 0; kx < kFilterSize; ++kx) {
+        const int in_x = in_x_origin + kx;
+        const int32_t w = filter[(ky * kFilterSize + kx) * g.depth + c];
+        if (in_y < 0 || in_y >= g.input_height || in_x < 0 ||
+            in_x >= g.input_width) {
+          padded_sum += static_cast<uint32_t>(w);
+          continue;
+        }
+        const int32_t x =
+            input_batch[(in_y * g.input_width + in_x) * g.depth + c];
+        acc += static_cast<uint32_t>(w * x);
+      }
+    }
+    output[c] = requantize(
+        acc - static_cast<uint32_t>(input_offset) * padded_sum, c);
+  }
+}
+
+// Interior pixels [x_begin, x_end) of one output row. For each channel the
+// nine taps stay in registers across the row; input points to the top-left
+// tap of pixel x_begin, channel 0.
+template <int kStride>
+inline void InteriorRow(const DepthwiseGeometry& g,
+                        const Requantizer& requantize,
+                        const int32_t* effective_bias, const int8_t* input,
+                        const int8_t* filter, int count, int8_t* output) {
+  const int row_stride = g.input_width * g.depth;
+  for (int c = 0; c < g.depth; ++c) {
+    int32_t w[kFilterTaps];
+#pragma GCC unroll 9
+    for (int k = 0; k < kFilterTaps; ++k) {
+      w[k] = filter[k * g.depth + c];
+    }
+    const uint32_t bias = static_cast<uint32_t>(effective_bias[c]);
+    const int8_t* in = input + c;
+    int8_t* out = output + c;
+    for (int i = 0; i < count; ++i) {
+      uint32_t acc = bias;
+#pragma GCC unroll 3
+      for (int ky = 0; ky < kFilterSize; ++ky) {
+#pragma GCC unroll 3
+        for (int kx = 0; kx < kFilterSize; ++kx) {
+          const int32_t x = in[ky * row_stride + kx * g.depth];
+          acc += static_cast<uint32_t>(w[ky * kFilterSize + kx] * x);
+        }
+      }
+      *out = requantize(acc, c);
+      in += kStride * g.depth;
+      out += g.depth;
+    }
+  }
+}
+
+template <int kStride>
+void DepthwiseConv3x3Int8(const DepthwiseParams& params,
+                          const int32_t* output_multiplier,
+                          const int32_t* output_shift,
+                          const int32_t* effective_bias,
+                          const RuntimeShape& input_shape,
+                          const int8_t* input_data,
+                          const RuntimeShape& filter_shape,
+                          const int8_t* filter_data,
+                          const RuntimeShape& output_shape,
+                          int8_t* output_data) {
+  TFLITE_DCHECK_EQ(params.stride_width, kStride);
+  TFLITE_DCHECK_EQ(params.stride_height, kStride);
+  DepthwiseGeometry g;
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  g.input_height = input_shape.Dims(1);
+  g.input_width = input_shape.Dims(2);
+  g.depth = MatchingDim(input_shape, 3, output_shape, 3);
+  g.output_height = output_shape.Dims(1);
+  g.output_width = output_shape.Dims(2);
+  g.pad_height = params.padding_values.height;
+  g.pad_width = params.padding_values.width;
+
+  const Requantizer requantize{params, output_multiplier, output_shift};
+
+  int y_begin, y_end, x_begin, x_end;
+  ConvInteriorRange(g.input_height, kFilterSize, kStride, g.pad_height,
+                    g.output_height, &y_begin, &y_end);
+  ConvInteriorRange(g.input_width, kFilterSize, kStride, g.pad_width,
+                    g.output_width, &x_begin, &x_end);
+
+  const int input_batch_size = g.input_height * g.input_width * g.depth;
+  for (int b = 0; b < batches; ++b) {
+    const int8_t* input_batch = input_data + b * input_batch_size;
+    for (int out_y = 0; out_y < g.output_height; ++out_y) {
+      const int in_y_origin = out_y * kStride - g.pad_height;
+      int8_t* output_row =
+          output_data +
+          ((b * g.output_height + out_y) * g.output_width) * g.depth;
+      const bool interior_row = out_y >= y_begin && out_y < y_end;
+      for (int out_x = 0; out_x < g.output_width; ++out_x) {
+        if (interior_row && out_x == x_begin && x_begin < x_end) {
+          InteriorRow<kStride>(
+              g, requantize, effective_bias,
+              input_batch + (in_y_origin * g.input_width + out_x * kStride -
+                             g.pad_width) *
+                                g.depth,
+              filter_data, x_end - x_begin, output_row + out_x * g.depth);
+          out_x = x_end - 1;
+          continue;
+        }
+        EdgePixel(g, requantize, effective_bias, params.input_offset,
+                  input_batch, in_y_origin, out_x * kStride - g.pad_width,
+                  filter_data, output_row + out_x * g.depth);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+DepthwiseConvInt8Kernel SelectDepthwiseConvInt8Kernel(
+    const DepthwiseParams& params, const RuntimeShape& input_shape,
+    const RuntimeShape& filter_shape, const RuntimeShape& output_shape) {
+  if (filter_shape.Dims(1) != kFilterSize ||
+      filter_shape.Dims(2) != kFilterSize ||
+      output_shape.Dims(3) != input_shape.Dims(3) ||
+      params.dilation_width_factor != 1 ||
+      params.dilation_height_factor != 1 ||
+      params.stride_width != params.stride_height) {
+    return nullptr;
+  }
+  switch (params.stride_width) {
+    case 1:
+      return DepthwiseConv3x3Int8<1>;
+    case 2:
+      return DepthwiseConv3x3Int8<2>;
+    default:
+      return nullptr;
+  }
+}
+
+void DepthwiseConvInt8EffectiveBias(const int8_t* filter,
+                                    const int32_t* bias, int output_depth,
+                                    int filter_taps, int32_t input_offset,
+                                    int32_t* effective_bias) {
+  for (int c = 0; c < output_depth; ++c) {
+    uint32_t filter_sum = 0;
+    for (int k = 0; k < filter_taps; ++k) {
+      filter_sum += static_cast<uint32_t>(
+          static_cast<int32_t>(filter[k * output_depth + c]));
+    }
+    uint32_t value = static_cast<uint32_t>(input_offset) * filter_sum;
+    if (bias) {
+      value += static_cast<uint32_t>(bias[c]);
+    }
+    effective_bias[c] = static_cast<int32_t>(value);
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,63 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_DEPTHWISE_CONV_INT8_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_DEPTHWISE_CONV_INT8_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// int8 x int8 per-channel depthwise Conv2D for RV32IM, bit-exact with
+// reference_integer_ops::DepthwiseConvPerChannel, specialized for the
+// layers that dominate keyword-spotting and MobileNet-style models:
+// 3x3 filters, stride 1 or 2 (same on both axes), no dilation and depth
+// multiplier 1.
+//
+// The generic reference loop handles any dilation and depth multiplier and
+// checks the image bounds for every tap. The specialized kernels are
+// template instances with the filter size and stride as constants:
+//  - input_offset * sum(filter[c]) and the bias are folded into a
+//    per-channel effective bias at Prepare time (as in the Conv2D kernel);
+//  - for each output row and channel, the nine filter taps and the
+//    requantization parameters are loaded once and kept in registers while
+//    the interior pixels of the row are computed, with no bounds checks;
+//  - edge pixels add (-input_offset) * filter for the taps in the padding.
+
+// Signature shared by the specialized kernels.
+using DepthwiseConvInt8Kernel = void (*)(
+    const DepthwiseParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const int32_t* effective_bias,
+    const RuntimeShape& input_shape, const int8_t* input_data,
+    const RuntimeShape& filter_shape, const int8_t* filter_data,
+    const RuntimeShape& output_shape, int8_t* output_data);
+
+// Returns the specialized kernel for the layer, or nullptr when the layer
+// needs the generic reference kernel. Called once, in Prepare.
+DepthwiseConvInt8Kernel SelectDepthwiseConvInt8Kernel(
+    const DepthwiseParams& params, const RuntimeShape& input_shape,
+    const RuntimeShape& filter_shape, const RuntimeShape& output_shape);
+
+// Fills effective_bias[0, output_depth) with
+// bias[c] + input_offset * sum_{ky,kx} filter[ky][kx][c]. bias may be null.
+void DepthwiseConvInt8EffectiveBias(const int8_t* filter,
+                                    const int32_t* bias, int output_depth,
+                                    int filter_taps, int32_t input_offset,
+                                    int32_t* effective_bias);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_DEPTHWISE_CONV_INT8_H_
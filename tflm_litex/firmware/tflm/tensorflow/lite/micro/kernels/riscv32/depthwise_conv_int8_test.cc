@@ -0,0 +1,150 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Host-side test: the kernels from SelectDepthwiseConvInt8Kernel() against
+// reference_integer_ops::DepthwiseConvPerChannel on random layers.
+// Built and run by `make test` in the TFLM directory.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/depthwise_conv.h"
+#include "tensorflow/lite/micro/kernels/riscv32/depthwise_conv_int8.h"
+#include "tensorflow/lite/micro/kernels/riscv32/test_util.h"
+
+namespace {
+
+using tflite::riscv32_test::Uniform;
+
+struct Layer : tflite::riscv32_test::LayerData {
+  int batches, input_height, input_width, depth;
+  int filter_height, filter_width, output_height, output_width;
+  tflite::DepthwiseParams params;
+};
+
+Layer RandomLayer(std::mt19937& rng, int iteration) {
+  Layer l;
+  l.params = tflite::DepthwiseParams();
+  // Mostly layers the specialized kernels take; every 8th one is a 1x1, 5x5,
+  // 3x2 or stride-3 layer that must be left to the reference kernel.
+  const bool unsupported = iteration % 8 == 7;
+  l.filter_height = unsupported ? Uniform(rng, 1, 5) : 3;
+  l.filter_width = unsupported ? Uniform(rng, 1, 5) : 3;
+  l.params.stride_height =
+      unsupported ? Uniform(rng, 1, 3) : 1 + iteration % 2;
+  l.params.stride_width =
+      unsupported ? Uniform(rng, 1, 3) : l.params.stride_height;
+  l.params.dilation_height_factor = 1;
+  l.params.dilation_width_factor = 1;
+  l.params.depth_multiplier = 1;
+  l.params.padding_values.height = Uniform(rng, 0, l.filter_height - 1);
+  l.params.padding_values.width = Uniform(rng, 0, l.filter_width - 1);
+  l.batches = Uniform(rng, 1, 2);
+  l.input_height = Uniform(rng, 1, 12);
+  l.input_width = Uniform(rng, 1, 12);
+  l.depth = Uniform(rng, 1, iteration % 4 == 1 ? 64 : 9);
+  l.output_height = (l.input_height + 2 * l.params.padding_values.height -
+                     l.filter_height) /
+                        l.params.stride_height +
+                    1;
+  l.output_width = (l.input_width + 2 * l.params.padding_values.width -
+                    l.filter_width) /
+                       l.params.stride_width +
+                   1;
+  l.with_bias = iteration % 5 != 0;
+
+  l.params.input_offset = Uniform(rng, -127, 128);
+  l.params.output_offset = Uniform(rng, -128, 127);
+  tflite::riscv32_test::RandomActivationRange(
+      rng, iteration, &l.params.quantized_activation_min,
+      &l.params.quantized_activation_max);
+
+  l.input.resize(l.batches * l.input_height * l.input_width * l.depth);
+  for (auto& v : l.input) v = Uniform(rng, -128, 127);
+  l.filter.resize(l.filter_height * l.filter_width * l.depth);
+  for (auto& v : l.filter) v = Uniform(rng, -127, 127);
+  tflite::riscv32_test::RandomChannelParams(rng, l.depth, &l);
+  return l;
+}
+
+// Returns the number of mismatches, or -1 when no kernel was selected.
+int CheckLayer(const Layer& l) {
+  const int32_t input_dims[] = {l.batches, l.input_height, l.input_width,
+                                l.depth};
+  const int32_t filter_dims[] = {1, l.filter_height, l.filter_width, l.depth};
+  const int32_t output_dims[] = {l.batches, l.output_height, l.output_width,
+                                 l.depth};
+  const tflite::RuntimeShape input_shape(4, input_dims);
+  const tflite::RuntimeShape filter_shape(4, filter_dims);
+  const tflite::RuntimeShape bias_shape(1, &l.depth);
+  const tflite::RuntimeShape output_shape(4, output_dims);
+
+  const tflite::DepthwiseConvInt8Kernel kernel =
+      tflite::SelectDepthwiseConvInt8Kernel(l.params, input_shape,
+                                            filter_shape, output_shape);
+  const bool expect_kernel = l.filter_height == 3 && l.filter_width == 3 &&
+                             l.params.stride_width == l.params.stride_height &&
+                             l.params.stride_width <= 2;
+  if ((kernel != nullptr) != expect_kernel) {
+    std::printf(">> FAIL: filter %dx%d stride %d,%d: wrong kernel selection\n",
+                l.filter_height, l.filter_width, l.params.stride_height,
+                l.params.stride_width);
+    return 1;
+  }
+  if (kernel == nullptr) return -1;
+
+  const int32_t* bias = l.with_bias ? l.bias.data() : nullptr;
+  std::vector<int8_t> expected(output_shape.FlatSize());
+  std::vector<int8_t> actual(expected.size());
+  std::vector<int32_t> effective_bias(l.depth);
+  tflite::reference_integer_ops::DepthwiseConvPerChannel(
+      l.params, l.multiplier.data(), l.shift.data(), input_shape,
+      l.input.data(), filter_shape, l.filter.data(), bias_shape, bias,
+      output_shape, expected.data());
+  tflite::DepthwiseConvInt8EffectiveBias(l.filter.data(), bias, l.depth, 9,
+                                         l.params.input_offset,
+                                         effective_bias.data());
+  kernel(l.params, l.multiplier.data(), l.shift.data(), effective_bias.data(),
+         input_shape, l.input.data(), filter_shape, l.filter.data(),
+         output_shape, actual.data());
+
+  char what[64];
+  std::snprintf(what, sizeof(what), "in %dx%dx%d stride %d pad %d,%d",
+                l.input_height, l.input_width, l.depth, l.params.stride_width,
+                l.params.padding_values.height, l.params.padding_values.width);
+  return tflite::riscv32_test::CountMismatches(what, actual, expected);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return tflite::riscv32_test::RunRandomCases(
+      argc, argv, 2000, "layers", [](std::mt19937& rng, int iteration) {
+        const Layer layer = RandomLayer(rng, iteration);
+        // Layers without output pixels or left to the reference kernel are
+        // skipped.
+        if (layer.output_height < 1 || layer.output_width < 1) {
+          return tflite::riscv32_test::CaseResult{0, 0};
+        }
+        const int errors = CheckLayer(layer);
+        if (errors < 0) return tflite::riscv32_test::CaseResult{0, 0};
+        return tflite::riscv32_test::CaseResult{
+            static_cast<long>(layer.batches) * layer.output_height *
+                layer.output_width * layer.depth,
+            errors};
+      });
+}
@@ -0,0 +1,206 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/riscv32/fully_connected_int8.h"
+
+#include <algorithm>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/micro/kernels/riscv32/mac_tile.h"
+
+namespace tflite {
+namespace {
+
+using riscv32::ClearTile;
+using riscv32::Int8Filter;
+using riscv32::PackedInt4Filter;
+using riscv32::RowSum;
+
+struct Requantizer {
+  const FullyConnectedParams& params;
+  const int32_t* per_channel_multiplier;
+  const int32_t* per_channel_shift;
+
+  int8_t operator()(int32_t acc, int out_c) const {
+    int32_t acc_scaled =
+        per_channel_multiplier
+            ? MultiplyByQuantizedMultiplier(acc,
+                                            per_channel_multiplier[out_c],
+                                            per_channel_shift[out_c])
+            : MultiplyByQuantizedMultiplier(acc, params.output_multiplier,
+                                            params.output_shift);
+    acc_scaled += params.output_offset;
+    acc_scaled = std::max(acc_scaled, params.quantized_activation_min);
+    acc_scaled = std::min(acc_scaled, params.quantized_activation_max);
+    return static_cast<int8_t>(acc_scaled);
+  }
+};
+
+// Computes and stores one tile of kRows batch rows x kCols output channels.
+template <typename Filter, int kRows, int kCols>
+inline void Tile(const Requantizer& requantize, const int32_t* effective_bias,
+                 const uint32_t* row_offset, const int8_t* input,
+                 const int8_t* filter, int accum_depth, int output_depth,
+                 int out_c, int8_t* output) {
+  uint32_t acc[kRows][kCols];
+  ClearTile<kRows, kCols>(acc);
+  Filter::template Mac<kRows, kCols>(input, accum_depth, filter,
+                                     out_c * accum_depth, accum_depth,
+                                     accum_depth, acc);
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kCols; ++c) {
+      const uint32_t total = acc[r][c] + row_offset[r] +
+                             static_cast<uint32_t>(effective_bias[out_c + c]);
+      output[r * output_depth + out_c + c] =
+          requantize(static_cast<int32_t>(total), out_c + c);
+    }
+  }
+}
+
+// All output channels of kRows batch rows: 4-channel tiles, then the rest.
+template <typename Filter, int kRows>
+inline void Rows(const Requantizer& requantize, const int32_t* effective_bias,
+                 int32_t filter_offset, const int8_t* input,
+                 const int8_t* filter, int accum_depth, int output_depth,
+                 int8_t* output) {
+  uint32_t row_offset[kRows];
+  for (int r = 0; r < kRows; ++r) {
+    row_offset[r] = filter_offset == 0
+                        ? 0
+                        : static_cast<uint32_t>(filter_offset) *
+                              RowSum(input + r * accum_depth, accum_depth);
+  }
+  int out_c = 0;
+  if (Filter::CanTile(accum_depth)) {
+    for (; out_c + 4 <= output_depth; out_c += 4) {
+      Tile<Filter, kRows, 4>(requantize, effective_bias, row_offset, input,
+                             filter, accum_depth, output_depth, out_c, output);
+    }
+  }
+  for (; out_c < output_depth; ++out_c) {
+    Tile<Filter, kRows, 1>(requantize, effective_bias, row_offset, input,
+                           filter, accum_depth, output_depth, out_c, output);
+  }
+}
+
+template <typename Filter>
+void EffectiveBias(const int8_t* filter, const int32_t* bias,
+                   int output_depth, int accum_depth, int32_t input_offset,
+                   int32_t filter_offset, int32_t* effective_bias) {
+  for (int out_c = 0; out_c < output_depth; ++out_c) {
+    const uint32_t filter_sum =
+        Filter::Sum(filter, out_c * accum_depth, accum_depth) +
+        static_cast<uint32_t>(filter_offset) *
+            static_cast<uint32_t>(accum_depth);
+    uint32_t value = static_cast<uint32_t>(input_offset) * filter_sum;
+    if (bias) {
+      value += static_cast<uint32_t>(bias[out_c]);
+    }
+    effective_bias[out_c] = static_cast<int32_t>(value);
+  }
+}
+
+template <typename Filter>
+void FullyConnected(const FullyConnectedParams& params,
+                    const int32_t* per_channel_multiplier,
+                    const int32_t* per_channel_shift,
+                    const int32_t* effective_bias,
+                    const RuntimeShape& input_shape, const int8_t* input_data,
+                    const RuntimeShape& filter_shape,
+                    const int8_t* filter_data,
+                    const RuntimeShape& output_shape, int8_t* output_data) {
+  TFLITE_DCHECK_GE(filter_shape.DimensionsCount(), 2);
+  TFLITE_DCHECK_GE(output_shape.DimensionsCount(), 1);
+  TFLITE_DCHECK_LE(params.quantized_activation_min,
+                   params.quantized_activation_max);
+  const int filter_dim_count = filter_shape.DimensionsCount();
+  const int output_dim_count = output_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dim_count - 1);
+  const int output_depth = output_shape.Dims(output_dim_count - 1);
+  TFLITE_DCHECK_LE(output_depth, filter_shape.Dims(filter_dim_count - 2));
+  const int accum_depth = filter_shape.Dims(filter_dim_count - 1);
+
+  const Requantizer requantize{params, per_channel_multiplier,
+                               per_channel_shift};
+  const int32_t filter_offset =
+      per_channel_multiplier ? 0 : params.weights_offset;
+
+  int b = 0;
+  for (; b + 4 <= batches; b += 4) {
+    Rows<Filter, 4>(requantize, effective_bias, filter_offset,
+                    input_data + b * accum_depth, filter_data, accum_depth,
+                    output_depth, output_data + b * output_depth);
+  }
+  for (; b < batches; ++b) {
+    Rows<Filter, 1>(requantize, effective_bias, filter_offset,
+                    input_data + b * accum_depth, filter_data, accum_depth,
+                    output_depth, output_data + b * output_depth);
+  }
+}
+
+}  // namespace
+
+void FullyConnectedInt8EffectiveBias(const int8_t* filter,
+                                     const int32_t* bias, int output_depth,
+                                     int accum_depth, int32_t input_offset,
+                                     int32_t filter_offset,
+                                     int32_t* effective_bias) {
+  EffectiveBias<Int8Filter>(filter, bias, output_depth, accum_depth,
+                            input_offset, filter_offset, effective_bias);
+}
+
+void FullyConnectedInt8Riscv32(const FullyConnectedParams& params,
+                               const int32_t* per_channel_multiplier,
+                               const int32_t* per_channel_shift,
+                               const int32_t* effective_bias,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& filter_shape,
+                               const int8_t* filter_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data) {
+  FullyConnected<Int8Filter>(params, per_channel_multiplier, per_channel_shift,
+                             effective_bias, input_shape, input_data,
+                             filter_shape, filter_data, output_shape,
+                             output_data);
+}
+
+void FullyConnectedInt4EffectiveBias(const int8_t* packed_filter,
+                                     const int32_t* bias, int output_depth,
+                                     int accum_depth, int32_t input_offset,
+                                     int32_t filter_offset,
+                                     int32_t* effective_bias) {
+  EffectiveBias<PackedInt4Filter>(packed_filter, bias, output_depth,
+                                  accum_depth, input_offset, filter_offset,
+                                  effective_bias);
+}
+
+void FullyConnectedInt4Riscv32(const FullyConnectedParams& params,
+                               const int32_t* per_channel_multiplier,
+                               const int32_t* per_channel_shift,
+                               const int32_t* effective_bias,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& filter_shape,
+                               const int8_t* packed_filter_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data) {
+  FullyConnected<PackedInt4Filter>(
+      params, per_channel_multiplier, per_channel_shift, effective_bias,
+      input_shape, input_data, filter_shape, packed_filter_data, output_shape,
+      output_data);
+}
+
+}  // namespace tflite
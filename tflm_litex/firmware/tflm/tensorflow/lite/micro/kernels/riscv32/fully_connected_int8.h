@@ -0,0 +1,87 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_FULLY_CONNECTED_INT8_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_FULLY_CONNECTED_INT8_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// int8 x int8 FullyConnected for RV32IM, bit-exact with
+// reference_integer_ops::FullyConnected and FullyConnectedPerChannel.
+//
+// The reference inner loop computes
+//   acc = sum_d (filter[c][d] + filter_offset) * (input[d] + input_offset)
+// for every output channel. Expanding the product leaves a single
+// filter[c][d] * input[d] term in the loop; the rest is folded into a
+// per-channel effective bias at Prepare time:
+//   effective_bias[c] = bias[c] +
+//       input_offset * (sum_d filter[c][d] + filter_offset * accum_depth)
+// plus filter_offset * sum_d input[d], computed once per input row (only
+// when filter_offset != 0). The sums are taken modulo 2^32, so the result
+// is the same int32 accumulator as the reference kernel's.
+
+// Fills effective_bias[0, output_depth). bias may be null. Per-channel
+// (symmetric) filters must pass filter_offset = 0, as the reference
+// per-channel kernel ignores the filter zero point.
+void FullyConnectedInt8EffectiveBias(const int8_t* filter,
+                                     const int32_t* bias, int output_depth,
+                                     int accum_depth, int32_t input_offset,
+                                     int32_t filter_offset,
+                                     int32_t* effective_bias);
+
+// Eval with the effective bias from FullyConnectedInt8EffectiveBias(). With
+// per_channel_multiplier/per_channel_shift set, requantization is per output
+// channel and params.weights_offset is ignored (FullyConnectedPerChannel);
+// otherwise params.output_multiplier/output_shift and params.weights_offset
+// are used (FullyConnected). Batch rows and output channels are computed in
+// 4x4 tiles so each loaded input and filter value feeds four MACs.
+void FullyConnectedInt8Riscv32(const FullyConnectedParams& params,
+                               const int32_t* per_channel_multiplier,
+                               const int32_t* per_channel_shift,
+                               const int32_t* effective_bias,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& filter_shape,
+                               const int8_t* filter_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data);
+
+// The same with packed int4 weights (kTfLiteInt4: two per byte, low nibble
+// first), read directly in the MAC loop instead of being unpacked into an
+// int8 copy. When accum_depth is odd, filter rows start mid-byte and
+// output channels are computed one at a time.
+void FullyConnectedInt4EffectiveBias(const int8_t* packed_filter,
+                                     const int32_t* bias, int output_depth,
+                                     int accum_depth, int32_t input_offset,
+                                     int32_t filter_offset,
+                                     int32_t* effective_bias);
+
+void FullyConnectedInt4Riscv32(const FullyConnectedParams& params,
+                               const int32_t* per_channel_multiplier,
+                               const int32_t* per_channel_shift,
+                               const int32_t* effective_bias,
+                               const RuntimeShape& input_shape,
+                               const int8_t* input_data,
+                               const RuntimeShape& filter_shape,
+                               const int8_t* packed_filter_data,
+                               const RuntimeShape& output_shape,
+                               int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_FULLY_CONNECTED_INT8_H_
@@ -0,0 +1,137 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Host-side test: FullyConnectedInt8Riscv32() and FullyConnectedInt4Riscv32()
+// against reference_integer_ops::FullyConnected{,PerChannel} on random layers.
+// Built and run by `make test` in the TFLM directory.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/fully_connected.h"
+#include "tensorflow/lite/micro/kernels/riscv32/fully_connected_int8.h"
+#include "tensorflow/lite/micro/kernels/riscv32/test_util.h"
+
+namespace {
+
+using tflite::riscv32_test::Uniform;
+
+struct Layer : tflite::riscv32_test::LayerData {
+  int batches, output_depth, accum_depth;
+  bool per_channel;
+  tflite::FullyConnectedParams params;
+};
+
+Layer RandomLayer(std::mt19937& rng, int iteration) {
+  Layer l;
+  // Shapes around the 4x4 tile boundaries, plus a few larger layers.
+  l.batches = Uniform(rng, 1, iteration % 8 == 0 ? 13 : 6);
+  l.output_depth = Uniform(rng, 1, iteration % 8 == 1 ? 67 : 9);
+  l.accum_depth = Uniform(rng, 1, iteration % 8 == 2 ? 400 : 33);
+  l.per_channel = iteration % 2;
+  l.with_bias = iteration % 5 != 0;
+  l.int4 = iteration % 3 == 1;
+
+  l.params = tflite::FullyConnectedParams();
+  l.params.input_offset = Uniform(rng, -127, 128);
+  l.params.weights_offset = l.per_channel ? 0 : Uniform(rng, -127, 128);
+  l.params.output_offset = Uniform(rng, -128, 127);
+  l.params.output_multiplier = Uniform(rng, 1 << 30, INT32_MAX);
+  l.params.output_shift = Uniform(rng, -12, 0);
+  tflite::riscv32_test::RandomActivationRange(
+      rng, iteration, &l.params.quantized_activation_min,
+      &l.params.quantized_activation_max);
+
+  // Saturated operands make the accumulator wrap in long rows.
+  const bool extreme = iteration % 7 == 0;
+  l.input.resize(l.batches * l.accum_depth);
+  for (auto& v : l.input) {
+    v = extreme ? (Uniform(rng, 0, 1) ? 127 : -128) : Uniform(rng, -128, 127);
+  }
+  l.filter.resize(l.output_depth * l.accum_depth);
+  const int filter_min = l.int4 ? -8 : -128, filter_max = l.int4 ? 7 : 127;
+  for (auto& v : l.filter) {
+    v = extreme ? filter_min : Uniform(rng, filter_min, filter_max);
+  }
+  if (l.int4) l.packed_filter = tflite::riscv32_test::PackInt4(l.filter);
+  tflite::riscv32_test::RandomChannelParams(rng, l.output_depth, &l);
+  return l;
+}
+
+int CheckLayer(const Layer& l) {
+  const int32_t input_dims[] = {l.batches, l.accum_depth};
+  const int32_t filter_dims[] = {l.output_depth, l.accum_depth};
+  const int32_t output_dims[] = {l.batches, l.output_depth};
+  const tflite::RuntimeShape input_shape(2, input_dims);
+  const tflite::RuntimeShape filter_shape(2, filter_dims);
+  const tflite::RuntimeShape bias_shape(1, &l.output_depth);
+  const tflite::RuntimeShape output_shape(2, output_dims);
+  const int32_t* bias = l.with_bias ? l.bias.data() : nullptr;
+
+  std::vector<int8_t> expected(l.batches * l.output_depth);
+  std::vector<int8_t> actual(expected.size());
+  std::vector<int32_t> effective_bias(l.output_depth);
+
+  if (l.per_channel) {
+    tflite::reference_integer_ops::FullyConnectedPerChannel(
+        l.params, l.multiplier.data(),
+        reinterpret_cast<const int*>(l.shift.data()), input_shape,
+        l.input.data(), filter_shape, l.filter.data(), bias_shape, bias,
+        output_shape, expected.data());
+  } else {
+    tflite::reference_integer_ops::FullyConnected(
+        l.params, input_shape, l.input.data(), filter_shape, l.filter.data(),
+        bias_shape, bias, output_shape, expected.data());
+  }
+
+  const int32_t* multiplier = l.per_channel ? l.multiplier.data() : nullptr;
+  const int32_t* shift = l.per_channel ? l.shift.data() : nullptr;
+  if (l.int4) {
+    tflite::FullyConnectedInt4EffectiveBias(
+        l.packed_filter.data(), bias, l.output_depth, l.accum_depth,
+        l.params.input_offset, l.params.weights_offset, effective_bias.data());
+    tflite::FullyConnectedInt4Riscv32(
+        l.params, multiplier, shift, effective_bias.data(), input_shape,
+        l.input.data(), filter_shape, l.packed_filter.data(), output_shape,
+        actual.data());
+  } else {
+    tflite::FullyConnectedInt8EffectiveBias(
+        l.filter.data(), bias, l.output_depth, l.accum_depth,
+        l.params.input_offset, l.params.weights_offset, effective_bias.data());
+    tflite::FullyConnectedInt8Riscv32(
+        l.params, multiplier, shift, effective_bias.data(), input_shape,
+        l.input.data(), filter_shape, l.filter.data(), output_shape,
+        actual.data());
+  }
+
+  char what[64];
+  std::snprintf(what, sizeof(what), "%s %dx%dx%d %s", l.int4 ? "int4" : "int8",
+                l.batches, l.output_depth, l.accum_depth,
+                l.per_channel ? "per-channel" : "per-tensor");
+  return tflite::riscv32_test::CountMismatches(what, actual, expected);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return tflite::riscv32_test::RunRandomCases(
+      argc, argv, 2000, "layers", [](std::mt19937& rng, int iteration) {
+        const Layer layer = RandomLayer(rng, iteration);
+        return tflite::riscv32_test::CaseResult{
+            layer.batches * layer.output_depth, CheckLayer(layer)};
+      });
+}
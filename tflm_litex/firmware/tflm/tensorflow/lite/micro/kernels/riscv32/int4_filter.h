@@ -0,0 +1,61 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_INT4_FILTER_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_INT4_FILTER_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/portable_tensor_utils.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+
+// Constant int4 filters of the riscv32 Conv2D and FullyConnected kernels.
+// The reference kernels unpack them into an arena scratch buffer on every
+// Invoke. Here each layer is set up once, in Prepare, in one of two ways:
+//  - filters whose unpacked size is at most RISCV32_INT4_CACHE_BYTES are
+//    unpacked once into a persistent buffer and run as int8 layers;
+//  - larger filters stay packed and run on the int4 kernels, which decode
+//    the nibbles in the MAC loop and need no copy at all.
+// The budget is per layer and comes out of the tensor arena, so it trades
+// arena space for the nibble decoding (two ALU operations per weight).
+#ifndef RISCV32_INT4_CACHE_BYTES
+#define RISCV32_INT4_CACHE_BYTES 1024
+#endif
+
+namespace tflite {
+namespace riscv32 {
+
+// Returns the filter unpacked to int8 in a persistent buffer when it fits
+// the budget, or null when the layer should read the packed filter.
+inline const int8_t* UnpackInt4FilterOnce(TfLiteContext* context,
+                                          const TfLiteTensor* filter) {
+  const int size = GetTensorShape(filter).FlatSize();
+  if (size > RISCV32_INT4_CACHE_BYTES) {
+    return nullptr;
+  }
+  int8_t* unpacked =
+      static_cast<int8_t*>(context->AllocatePersistentBuffer(context, size));
+  if (unpacked == nullptr) {
+    return nullptr;
+  }
+  tensor_utils::UnpackDenseInt4IntoInt8(GetTensorData<int8_t>(filter), size,
+                                        unpacked);
+  return unpacked;
+}
+
+}  // namespace riscv32
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_INT4_FILTER_H_
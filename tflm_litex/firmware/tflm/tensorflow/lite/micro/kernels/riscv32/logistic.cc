@@ -0,0 +1,150 @@
+/* Copyright 2021 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Logistic for RV32IM targets (OPTIMIZED_KERNEL_DIR=riscv32).
+//
+// Same as the reference kernel except for the integer types: int8 input
+// reads a 256-entry output table computed once in Prepare from the input
+// quantization, int16 input runs the interpolated LogisticInt16Riscv32().
+
+#include "tensorflow/lite/micro/kernels/logistic.h"
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/logistic.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/riscv32/activation_lut.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+struct OpDataLogisticRiscv32 {
+  // Must stay first: LogisticPrepare() uses it as OpDataLogistic.
+  OpDataLogistic reference;
+  // Output for each int8 input value (persistent), null otherwise.
+  int8_t* lut;
+};
+
+void* LogisticInitRiscv32(TfLiteContext* context, const char* buffer,
+                          size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context,
+                                           sizeof(OpDataLogisticRiscv32));
+}
+
+TfLiteStatus LogisticPrepareRiscv32(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_OK(context, LogisticPrepare(context, node));
+
+  auto* data = static_cast<OpDataLogisticRiscv32*>(node->user_data);
+  data->lut = nullptr;
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kLogisticInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  const bool int8 = input->type == kTfLiteInt8;
+  micro_context->DeallocateTempTfLiteTensor(input);
+
+  if (int8) {
+    data->lut = static_cast<int8_t*>(
+        context->AllocatePersistentBuffer(context, kActivationInt8LutSize));
+    TF_LITE_ENSURE(context, data->lut != nullptr);
+    const OpDataLogistic& params = data->reference;
+    LogisticInt8Lut(params.input_zero_point, params.input_range_radius,
+                    params.input_multiplier, params.input_left_shift,
+                    data->lut);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus LogisticEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kLogisticInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kLogisticOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *static_cast<const OpDataLogisticRiscv32*>(node->user_data);
+
+  if (input->type == kTfLiteFloat32) {
+    switch (output->type) {
+      case kTfLiteFloat32: {
+        reference_ops::Logistic(tflite::micro::GetTensorShape(input),
+                                tflite::micro::GetTensorData<float>(input),
+                                tflite::micro::GetTensorShape(output),
+                                tflite::micro::GetTensorData<float>(output));
+        return kTfLiteOk;
+      }
+      default:
+        MicroPrintf("Input %s, output %s not supported.",
+                    TfLiteTypeGetName(input->type),
+                    TfLiteTypeGetName(output->type));
+        return kTfLiteError;
+    }
+  } else if (input->type == kTfLiteInt16) {
+    switch (output->type) {
+      case kTfLiteInt16: {
+        LogisticInt16Riscv32(data.reference.input_multiplier,
+                             data.reference.input_left_shift,
+                             NumElements(input->dims),
+                             tflite::micro::GetTensorData<int16_t>(input),
+                             tflite::micro::GetTensorData<int16_t>(output));
+        return kTfLiteOk;
+      }
+      default:
+        MicroPrintf("Input %s, output %s not supported.",
+                    TfLiteTypeGetName(input->type),
+                    TfLiteTypeGetName(output->type));
+        return kTfLiteError;
+    }
+  } else if (input->type == kTfLiteInt8) {
+    switch (output->type) {
+      case kTfLiteInt8: {
+        ActivationInt8Riscv32(data.lut, NumElements(input->dims),
+                              tflite::micro::GetTensorData<int8_t>(input),
+                              tflite::micro::GetTensorData<int8_t>(output));
+        return kTfLiteOk;
+      }
+      default:
+        MicroPrintf("Input %s, output %s not supported.",
+                    TfLiteTypeGetName(input->type),
+                    TfLiteTypeGetName(output->type));
+        return kTfLiteError;
+    }
+  } else {
+    // TODO(b/141211002): Also support other data types once we have supported
+    // temporary tensors in TFLM.
+    MicroPrintf("Input %s, output %s not supported.",
+                TfLiteTypeGetName(input->type),
+                TfLiteTypeGetName(output->type));
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration Register_LOGISTIC() {
+  return tflite::micro::RegisterOp(LogisticInitRiscv32, LogisticPrepareRiscv32,
+                                   LogisticEval);
+}
+}  // namespace tflite
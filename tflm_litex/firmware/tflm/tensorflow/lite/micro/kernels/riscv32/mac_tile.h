@@ -0,0 +1,184 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_MAC_TILE_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_MAC_TILE_H_
+
+#include <cstdint>
+
+namespace tflite {
+namespace riscv32 {
+
+// Accumulators are kept as uint32_t: the reference kernels' int32 sums wrap
+// in practice, and unsigned arithmetic gives the same bits without UB.
+
+// acc[r][c] += sum_{d < len} input[r * input_stride + d] *
+//                            filter[c * filter_stride + d]
+// Each loaded input value feeds kCols MACs and each filter value kRows, so
+// the loop does kRows + kCols loads for kRows * kCols MACs. RV32 has 31
+// usable registers: 4x4 tiles fit when the strides are equal (FC), 2x4 when
+// input and filter rows need separate address computations (Conv).
+template <int kRows, int kCols>
+inline void MacTile(const int8_t* input, int input_stride,
+                    const int8_t* filter, int filter_stride, int len,
+                    uint32_t acc[kRows][kCols]) {
+  for (int d = 0; d < len; ++d) {
+    int32_t x[kRows];
+    int32_t w[kCols];
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+      x[r] = input[r * input_stride + d];
+    }
+#pragma GCC unroll 4
+    for (int c = 0; c < kCols; ++c) {
+      w[c] = filter[c * filter_stride + d];
+    }
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+#pragma GCC unroll 4
+      for (int c = 0; c < kCols; ++c) {
+        acc[r][c] += static_cast<uint32_t>(x[r] * w[c]);
+      }
+    }
+  }
+}
+
+template <int kRows, int kCols>
+inline void ClearTile(uint32_t acc[kRows][kCols]) {
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kCols; ++c) {
+      acc[r][c] = 0;
+    }
+  }
+}
+
+// sum_{d < len} row[d], modulo 2^32.
+inline uint32_t RowSum(const int8_t* row, int len) {
+  uint32_t sum = 0;
+  for (int d = 0; d < len; ++d) {
+    sum += static_cast<uint32_t>(static_cast<int32_t>(row[d]));
+  }
+  return sum;
+}
+
+// Packed int4 values (kTfLiteInt4): element 2i is the low nibble of byte i
+// and element 2i + 1 the high nibble, as in UnpackDenseInt4IntoInt8().
+inline int32_t Int4Low(int8_t byte) {
+  return static_cast<int8_t>(byte << 4) >> 4;
+}
+inline int32_t Int4High(int8_t byte) { return byte >> 4; }
+inline int32_t Int4At(const int8_t* packed, int index) {
+  return (index & 1) ? Int4High(packed[index >> 1])
+                     : Int4Low(packed[index >> 1]);
+}
+
+// MacTile() with a packed int4 filter: filter rows start at element indices
+// index + c * filter_stride. Both nibbles of each loaded byte are used, so
+// the loop still does one filter load per two MACs per row. With kCols > 1
+// filter_stride must be even (all rows at the same nibble parity).
+template <int kRows, int kCols>
+inline void MacTileInt4(const int8_t* input, int input_stride,
+                        const int8_t* filter, int index, int filter_stride,
+                        int len, uint32_t acc[kRows][kCols]) {
+  const int byte_stride = filter_stride >> 1;
+  int d = 0;
+  if ((index & 1) && len > 0) {
+    const int8_t* f = filter + (index >> 1);
+    for (int r = 0; r < kRows; ++r) {
+      const int32_t x = input[r * input_stride];
+      for (int c = 0; c < kCols; ++c) {
+        acc[r][c] += static_cast<uint32_t>(x * Int4High(f[c * byte_stride]));
+      }
+    }
+    d = 1;
+  }
+  const int8_t* f = filter + ((index + d) >> 1);
+  for (; d + 2 <= len; d += 2, ++f) {
+    int32_t x0[kRows];
+    int32_t x1[kRows];
+    int32_t w0[kCols];
+    int32_t w1[kCols];
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+      x0[r] = input[r * input_stride + d];
+      x1[r] = input[r * input_stride + d + 1];
+    }
+#pragma GCC unroll 4
+    for (int c = 0; c < kCols; ++c) {
+      const int8_t byte = f[c * byte_stride];
+      w0[c] = Int4Low(byte);
+      w1[c] = Int4High(byte);
+    }
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+#pragma GCC unroll 4
+      for (int c = 0; c < kCols; ++c) {
+        acc[r][c] += static_cast<uint32_t>(x0[r] * w0[c] + x1[r] * w1[c]);
+      }
+    }
+  }
+  if (d < len) {
+    for (int r = 0; r < kRows; ++r) {
+      const int32_t x = input[r * input_stride + d];
+      for (int c = 0; c < kCols; ++c) {
+        acc[r][c] += static_cast<uint32_t>(x * Int4Low(f[c * byte_stride]));
+      }
+    }
+  }
+}
+
+// sum_{d < len} of the int4 elements from index, modulo 2^32.
+inline uint32_t RowSumInt4(const int8_t* packed, int index, int len) {
+  uint32_t sum = 0;
+  for (int d = 0; d < len; ++d) {
+    sum += static_cast<uint32_t>(Int4At(packed, index + d));
+  }
+  return sum;
+}
+
+// Filter layouts for the kernels templated on them. Positions in the filter
+// are element indices, so the same tile code walks either layout.
+struct Int8Filter {
+  // Whether Mac() can take kCols > 1 rows filter_stride elements apart.
+  static bool CanTile(int filter_stride) { return true; }
+  template <int kRows, int kCols>
+  static void Mac(const int8_t* input, int input_stride, const int8_t* filter,
+                  int index, int filter_stride, int len,
+                  uint32_t acc[kRows][kCols]) {
+    MacTile<kRows, kCols>(input, input_stride, filter + index, filter_stride,
+                          len, acc);
+  }
+  static uint32_t Sum(const int8_t* filter, int index, int len) {
+    return RowSum(filter + index, len);
+  }
+};
+
+struct PackedInt4Filter {
+  static bool CanTile(int filter_stride) { return filter_stride % 2 == 0; }
+  template <int kRows, int kCols>
+  static void Mac(const int8_t* input, int input_stride, const int8_t* filter,
+                  int index, int filter_stride, int len,
+                  uint32_t acc[kRows][kCols]) {
+    MacTileInt4<kRows, kCols>(input, input_stride, filter, index,
+                              filter_stride, len, acc);
+  }
+  static uint32_t Sum(const int8_t* filter, int index, int len) {
+    return RowSumInt4(filter, index, len);
+  }
+};
+
+}  // namespace riscv32
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_MAC_TILE_H_
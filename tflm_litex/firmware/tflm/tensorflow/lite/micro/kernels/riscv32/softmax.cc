@@ -0,0 +1,133 @@
+/* Copyright 2021 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Softmax for RV32IM targets (OPTIMIZED_KERNEL_DIR=riscv32).
+//
+// Same as the reference kernel except for int8 input, which runs
+// SoftmaxInt8Riscv32() with an exp table computed once in Prepare from the
+// input scale and beta.
+
+#include "tensorflow/lite/micro/kernels/softmax.h"
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/softmax.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/riscv32/softmax_int8.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+struct OpDataSoftmaxRiscv32 {
+  // Must stay first: SoftmaxPrepare() uses it as SoftmaxParams.
+  SoftmaxParams reference;
+  // exp_table[max - x] for int8 input (persistent), null otherwise.
+  int32_t* exp_table;
+};
+
+void* SoftmaxInitRiscv32(TfLiteContext* context, const char* buffer,
+                         size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context,
+                                           sizeof(OpDataSoftmaxRiscv32));
+}
+
+TfLiteStatus SoftmaxPrepareRiscv32(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_OK(context, SoftmaxPrepare(context, node));
+
+  auto* data = static_cast<OpDataSoftmaxRiscv32*>(node->user_data);
+  data->exp_table = nullptr;
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input = micro_context->AllocateTempInputTensor(node, 0);
+  TF_LITE_ENSURE(context, input != nullptr);
+  const bool int8 = input->type == kTfLiteInt8;
+  micro_context->DeallocateTempTfLiteTensor(input);
+
+  if (int8) {
+    data->exp_table = static_cast<int32_t*>(context->AllocatePersistentBuffer(
+        context, kSoftmaxInt8ExpTableSize * sizeof(int32_t)));
+    TF_LITE_ENSURE(context, data->exp_table != nullptr);
+    SoftmaxInt8ExpTable(data->reference, data->exp_table);
+  }
+  return kTfLiteOk;
+}
+
+void SoftmaxQuantized(const TfLiteEvalTensor* input, TfLiteEvalTensor* output,
+                      const SoftmaxParams& op_data, const int32_t* exp_table) {
+  if (input->type == kTfLiteInt8) {
+    if (output->type == kTfLiteInt16) {
+      SoftmaxInt8Riscv32(exp_table, tflite::micro::GetTensorShape(input),
+                         tflite::micro::GetTensorData<int8_t>(input),
+                         tflite::micro::GetTensorShape(output),
+                         tflite::micro::GetTensorData<int16_t>(output));
+    } else {
+      SoftmaxInt8Riscv32(exp_table, tflite::micro::GetTensorShape(input),
+                         tflite::micro::GetTensorData<int8_t>(input),
+                         tflite::micro::GetTensorShape(output),
+                         tflite::micro::GetTensorData<int8_t>(output));
+    }
+  } else {
+    tflite::reference_ops::SoftmaxInt16(
+        op_data, tflite::micro::GetTensorShape(input),
+        tflite::micro::GetTensorData<int16_t>(input),
+        tflite::micro::GetTensorShape(output),
+        tflite::micro::GetTensorData<int16_t>(output));
+  }
+}
+
+TfLiteStatus SoftmaxEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input = tflite::micro::GetEvalInput(context, node, 0);
+  TfLiteEvalTensor* output = tflite::micro::GetEvalOutput(context, node, 0);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *static_cast<const OpDataSoftmaxRiscv32*>(node->user_data);
+  const SoftmaxParams& op_data = data.reference;
+
+  switch (input->type) {
+    case kTfLiteFloat32: {
+      tflite::reference_ops::Softmax(
+          op_data, tflite::micro::GetTensorShape(input),
+          tflite::micro::GetTensorData<float>(input),
+          tflite::micro::GetTensorShape(output),
+          tflite::micro::GetTensorData<float>(output));
+      return kTfLiteOk;
+    }
+    case kTfLiteInt8:
+    case kTfLiteInt16: {
+      SoftmaxQuantized(input, output, op_data, data.exp_table);
+      return kTfLiteOk;
+    }
+    default:
+      MicroPrintf("Type %s (%d) not supported.", TfLiteTypeGetName(input->type),
+                  input->type);
+      return kTfLiteError;
+  }
+}
+}  // namespace
+
+TFLMRegistration Register_SOFTMAX() {
+  return tflite::micro::RegisterOp(SoftmaxInitRiscv32, SoftmaxPrepareRiscv32,
+                                   SoftmaxEval);
+}
+
+}  // namespace tflite
@@ -0,0 +1,118 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/riscv32/softmax_int8.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "fixedpoint/fixedpoint.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+
+namespace tflite {
+namespace {
+
+// Same fixed-point formats as the reference kernel.
+constexpr int kScaledDiffIntegerBits = 5;
+constexpr int kAccumulationIntegerBits = 12;
+using FixedPointScaledDiff =
+    gemmlowp::FixedPoint<int32_t, kScaledDiffIntegerBits>;
+using FixedPointAccum = gemmlowp::FixedPoint<int32_t, kAccumulationIntegerBits>;
+using FixedPoint0 = gemmlowp::FixedPoint<int32_t, 0>;
+
+template <typename OutputT>
+void Softmax(const int32_t* exp_table, const RuntimeShape& input_shape,
+             const int8_t* input_data, const RuntimeShape& output_shape,
+             OutputT* output_data) {
+  const int trailing_dim = input_shape.DimensionsCount() - 1;
+  const int outer_size =
+      MatchingFlatSizeSkipDim(input_shape, trailing_dim, output_shape);
+  const int depth =
+      MatchingDim(input_shape, trailing_dim, output_shape, trailing_dim);
+  constexpr int32_t kOutputMin = std::numeric_limits<OutputT>::min();
+  constexpr int32_t kOutputMax = std::numeric_limits<OutputT>::max();
+
+  for (int i = 0; i < outer_size; ++i) {
+    const int8_t* input = input_data + i * depth;
+    OutputT* output = output_data + i * depth;
+
+    int32_t max_in_row = std::numeric_limits<int8_t>::min();
+    for (int c = 0; c < depth; ++c) {
+      max_in_row = std::max(max_in_row, static_cast<int32_t>(input[c]));
+    }
+
+    FixedPointAccum sum_of_exps = FixedPointAccum::Zero();
+    for (int c = 0; c < depth; ++c) {
+      const FixedPoint0 exp_in_0 =
+          FixedPoint0::FromRaw(exp_table[max_in_row - input[c]]);
+      sum_of_exps =
+          sum_of_exps + gemmlowp::Rescale<kAccumulationIntegerBits>(exp_in_0);
+    }
+
+    int num_bits_over_unit;
+    const FixedPoint0 shifted_scale = FixedPoint0::FromRaw(GetReciprocal(
+        sum_of_exps.raw(), kAccumulationIntegerBits, &num_bits_over_unit));
+    const int exponent = num_bits_over_unit + 31 - (sizeof(OutputT) * 8);
+    TFLITE_CHECK(0 <= exponent && exponent <= 31);
+
+    for (int c = 0; c < depth; ++c) {
+      const int32_t unsat_output = gemmlowp::RoundingDivideByPOT(
+          (shifted_scale *
+           FixedPoint0::FromRaw(exp_table[max_in_row - input[c]]))
+              .raw(),
+          exponent);
+      output[c] = static_cast<OutputT>(
+          std::max(std::min(unsat_output + kOutputMin, kOutputMax),
+                   kOutputMin));
+    }
+  }
+}
+
+}  // namespace
+
+void SoftmaxInt8ExpTable(const SoftmaxParams& params, int32_t* exp_table) {
+  for (int diff = 0; diff < kSoftmaxInt8ExpTableSize; ++diff) {
+    const int32_t input_diff = -diff;
+    if (input_diff < params.diff_min) {
+      exp_table[diff] = 0;
+      continue;
+    }
+    const int32_t input_diff_rescaled =
+        MultiplyByQuantizedMultiplierGreaterThanOne(
+            input_diff, params.input_multiplier, params.input_left_shift);
+    exp_table[diff] =
+        exp_on_negative_values(
+            FixedPointScaledDiff::FromRaw(input_diff_rescaled))
+            .raw();
+  }
+}
+
+void SoftmaxInt8Riscv32(const int32_t* exp_table,
+                        const RuntimeShape& input_shape,
+                        const int8_t* input_data,
+                        const RuntimeShape& output_shape,
+                        int8_t* output_data) {
+  Softmax(exp_table, input_shape, input_data, output_shape, output_data);
+}
+
+void SoftmaxInt8Riscv32(const int32_t* exp_table,
+                        const RuntimeShape& input_shape,
+                        const int8_t* input_data,
+                        const RuntimeShape& output_shape,
+                        int16_t* output_data) {
+  Softmax(exp_table, input_shape, input_data, output_shape, output_data);
+}
+
+}  // namespace tflite
@@ -0,0 +1,55 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_SOFTMAX_INT8_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_SOFTMAX_INT8_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// int8-input Softmax for RV32IM, bit-exact with the reference
+// reference_ops::Softmax<int8_t, int8_t/int16_t>.
+//
+// The reference kernel evaluates exp(beta * scale * (x - max)) twice per
+// element with gemmlowp's fixed-point exp_on_negative_values (a polynomial
+// plus a chain of barrel-shifter multiplications). For int8 input,
+// max - x takes one of 256 values, so the Q0.31 results are tabulated once
+// in Prepare; Eval is a max pass, a table lookup and sum pass, and a
+// normalization pass with one multiplication per element.
+
+constexpr int kSoftmaxInt8ExpTableSize = 256;
+
+// Fills exp_table[max - x] (kSoftmaxInt8ExpTableSize entries) from the
+// input multiplier, left shift and diff_min of params. Differences below
+// diff_min, which the reference kernel skips, get 0.
+void SoftmaxInt8ExpTable(const SoftmaxParams& params, int32_t* exp_table);
+
+void SoftmaxInt8Riscv32(const int32_t* exp_table,
+                        const RuntimeShape& input_shape,
+                        const int8_t* input_data,
+                        const RuntimeShape& output_shape,
+                        int8_t* output_data);
+
+void SoftmaxInt8Riscv32(const int32_t* exp_table,
+                        const RuntimeShape& input_shape,
+                        const int8_t* input_data,
+                        const RuntimeShape& output_shape,
+                        int16_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_SOFTMAX_INT8_H_
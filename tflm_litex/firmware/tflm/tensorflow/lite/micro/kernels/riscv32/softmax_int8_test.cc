@@ -0,0 +1,94 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Host-side test: SoftmaxInt8Riscv32() against reference_ops::Softmax with
+// int8 and int16 outputs, on random rows, input scales and betas.
+// Built and run by `make test` in the TFLM directory.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/softmax.h"
+#include "tensorflow/lite/micro/kernels/riscv32/softmax_int8.h"
+#include "tensorflow/lite/micro/kernels/riscv32/test_util.h"
+
+namespace {
+
+using tflite::riscv32_test::Uniform;
+
+// The int8 parameters CalculateSoftmaxParams() derives from beta and the
+// input scale.
+tflite::SoftmaxParams Params(double beta, double input_scale) {
+  constexpr int kScaledDiffIntegerBits = 5;
+  tflite::SoftmaxParams params = {};
+  int input_left_shift;
+  tflite::PreprocessSoftmaxScaling(beta, input_scale, kScaledDiffIntegerBits,
+                                   &params.input_multiplier,
+                                   &input_left_shift);
+  params.input_left_shift = input_left_shift;
+  params.diff_min = -1.0 * tflite::CalculateInputRadius(kScaledDiffIntegerBits,
+                                                        input_left_shift);
+  return params;
+}
+
+template <typename OutputT>
+int Check(const tflite::SoftmaxParams& params, const int32_t* exp_table,
+          const tflite::RuntimeShape& shape, const std::vector<int8_t>& input) {
+  std::vector<OutputT> expected(input.size()), actual(input.size());
+  tflite::reference_ops::Softmax(params, shape, input.data(), shape,
+                                 expected.data());
+  tflite::SoftmaxInt8Riscv32(exp_table, shape, input.data(), shape,
+                             actual.data());
+  char what[48];
+  std::snprintf(what, sizeof(what), "int%d output, depth %d",
+                static_cast<int>(sizeof(OutputT) * 8), shape.Dims(1));
+  return tflite::riscv32_test::CountMismatches(what, actual, expected);
+}
+
+tflite::riscv32_test::CaseResult CheckRowSet(std::mt19937& rng,
+                                             int iteration) {
+  // Input scales from classifier heads (~0.05-0.2) to wide ranges, where
+  // most differences fall below diff_min.
+  const double input_scale = Uniform(rng, 1, 400) / 1000.0;
+  const double beta = iteration % 4 == 0 ? Uniform(rng, 1, 40) / 10.0 : 1.0;
+  const tflite::SoftmaxParams params = Params(beta, input_scale);
+  int32_t exp_table[tflite::kSoftmaxInt8ExpTableSize];
+  tflite::SoftmaxInt8ExpTable(params, exp_table);
+
+  // With int8 output the reference kernel requires sum(exp) < 2^8 (its
+  // TFLITE_CHECK on the output exponent), so rows stay under 256 values.
+  const int32_t dims[] = {Uniform(rng, 1, 3),
+                          Uniform(rng, 1, iteration % 8 == 0 ? 250 : 40)};
+  const tflite::RuntimeShape shape(2, dims);
+  std::vector<int8_t> input(shape.FlatSize());
+  const int spread = Uniform(rng, 0, 255);
+  const int low = Uniform(rng, -128, 127 - spread);
+  for (auto& v : input) v = Uniform(rng, low, low + spread);
+
+  const int errors = iteration % 2
+                         ? Check<int16_t>(params, exp_table, shape, input)
+                         : Check<int8_t>(params, exp_table, shape, input);
+  return {static_cast<long>(input.size()), errors};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return tflite::riscv32_test::RunRandomCases(argc, argv, 2000, "row sets",
+                                              CheckRowSet);
+}
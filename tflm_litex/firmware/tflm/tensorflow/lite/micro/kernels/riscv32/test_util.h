@@ -0,0 +1,131 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_TEST_UTIL_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_TEST_UTIL_H_
+
+// Scaffolding shared by the host-side tests of the riscv32 kernels
+// (riscv32/*_test.cc, built and run by `make test`): each test checks an
+// optimized kernel against the reference one on random cases.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace tflite {
+namespace riscv32_test {
+
+inline int Uniform(std::mt19937& rng, int lo, int hi) {
+  return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+// Packs int4 values two per byte, low nibble first (kTfLiteInt4).
+inline std::vector<int8_t> PackInt4(const std::vector<int8_t>& values) {
+  std::vector<int8_t> packed((values.size() + 1) / 2, 0);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const int nibble = values[i] & 0xf;
+    packed[i / 2] =
+        static_cast<int8_t>(packed[i / 2] | (i % 2 ? nibble << 4 : nibble));
+  }
+  return packed;
+}
+
+// Operands of a random int8 layer; each test derives its Layer from it and
+// adds the shapes and the kernel's params.
+struct LayerData {
+  bool with_bias = true;
+  bool int4 = false;
+  // packed_filter: the int4 weights of an int4 layer, two per byte.
+  std::vector<int8_t> input, filter, packed_filter;
+  std::vector<int32_t> bias, multiplier, shift;
+};
+
+// Random bias and per-channel requantization for `channels` outputs.
+inline void RandomChannelParams(std::mt19937& rng, int channels,
+                                LayerData* layer) {
+  layer->bias.resize(channels);
+  for (auto& v : layer->bias) v = Uniform(rng, -(1 << 20), 1 << 20);
+  layer->multiplier.resize(channels);
+  layer->shift.resize(channels);
+  for (int c = 0; c < channels; ++c) {
+    layer->multiplier[c] = Uniform(rng, 1 << 30, INT32_MAX);
+    layer->shift[c] = Uniform(rng, -12, 0);
+  }
+}
+
+// The full int8 range for every third layer, a random clamp otherwise.
+inline void RandomActivationRange(std::mt19937& rng, int iteration,
+                                  int32_t* activation_min,
+                                  int32_t* activation_max) {
+  *activation_min = iteration % 3 == 0 ? -128 : Uniform(rng, -128, 0);
+  *activation_max = iteration % 3 == 0 ? 127 : Uniform(rng, 0, 127);
+}
+
+// Number of outputs that differ from the reference; the first few are
+// printed after `what` (the case being checked).
+template <typename T>
+int CountMismatches(const char* what, const std::vector<T>& actual,
+                    const std::vector<T>& expected) {
+  int errors = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (actual[i] == expected[i]) continue;
+    if (errors < 4) {
+      std::printf(">> FAIL: %s, output %zu = %d, expected %d\n", what, i,
+                  static_cast<int>(actual[i]), static_cast<int>(expected[i]));
+    }
+    errors++;
+  }
+  return errors;
+}
+
+// What check_case(rng, iteration) returns: the number of outputs compared
+// (0 when the random case does not apply and is skipped) and of mismatches.
+struct CaseResult {
+  long outputs;
+  int errors;
+};
+
+// Runs argv[1] (default `default_iterations`) random cases from seed argv[2]
+// (default 1) and prints the >> PASS / >> FAIL line; `cases` names them in
+// that line. Returns the exit status of the test.
+template <typename CheckCase>
+int RunRandomCases(int argc, char** argv, int default_iterations,
+                   const char* cases, CheckCase check_case) {
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : default_iterations;
+  std::mt19937 rng(argc > 2 ? std::atoi(argv[2]) : 1);
+
+  int failed = 0, checked = 0;
+  long outputs = 0;
+  for (int i = 0; i < iterations; ++i) {
+    const CaseResult result = check_case(rng, i);
+    if (result.outputs == 0) continue;
+    checked++;
+    outputs += result.outputs;
+    if (result.errors != 0) failed++;
+  }
+  if (failed == 0) {
+    std::printf(">> PASS: %d %s, %ld outputs bit-exact with the reference\n",
+                checked, cases, outputs);
+    return EXIT_SUCCESS;
+  }
+  std::printf(">> FAIL: %d of %d %s differ\n", failed, checked, cases);
+  return EXIT_FAILURE;
+}
+
+}  // namespace riscv32_test
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RISCV32_TEST_UTIL_H_
@@ -243,6 +243,12 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
       &allocation_info[info_.subgraph_offsets[subgraph_idx]];
 
   uint32_t operators_size = NumSubgraphOperators(subgraph);
+  // Tensor indices come from the nodes rather than the flatbuffer operators:
+  // they are the same unless a graph pass rewired them
+  // (MicroInterpreterGraph::FuseSubgraphs()), and the nodes are what the
+  // kernels read.
+  const NodeAndRegistration* nodes =
+      allocations[subgraph_idx].node_and_registrations;
   // Mark all inputs as created at the start of the subgraph invocation.
   for (size_t i = 0;
        subgraph->inputs() != nullptr && i < subgraph->inputs()->size(); ++i) {
@@ -258,10 +264,10 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
     // Each operator has a new allocation scope.
     allocation_scope_count_++;
     const auto* op = subgraph->operators()->Get(i);
+    const TfLiteNode& node = nodes[i].node;
     // Figure out when the first creation and use of each tensor is.
-    for (size_t n = 0; op->outputs() != nullptr && n < op->outputs()->size();
-         ++n) {
-      const int tensor_index = op->outputs()->Get(n);
+    for (int n = 0; node.outputs != nullptr && n < node.outputs->size; ++n) {
+      const int tensor_index = node.outputs->data[n];
       AllocationInfo* current = &subgraph_allocation_info[tensor_index];
       UpdateFirstCreated(current, allocation_scope_count_);
     }
@@ -276,9 +282,8 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
                                      scratch_buffer_handles, allocations);
 
     // Figure out when the last use of each tensor is.
-    for (size_t n = 0; op->inputs() != nullptr && n < op->inputs()->size();
-         ++n) {
-      const int tensor_index = op->inputs()->Get(n);
+    for (int n = 0; node.inputs != nullptr && n < node.inputs->size; ++n) {
+      const int tensor_index = node.inputs->data[n];
       // Optional bias tensors can have an index of -1 when they are omitted.
       if (tensor_index >= 0) {
         AllocationInfo* current = &subgraph_allocation_info[tensor_index];
@@ -288,9 +293,8 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
         UpdateLastUsed(current, allocation_scope_count_);
       }
     }
-    for (size_t n = 0; op->outputs() != nullptr && n < op->outputs()->size();
-         ++n) {
-      const int tensor_index = op->outputs()->Get(n);
+    for (int n = 0; node.outputs != nullptr && n < node.outputs->size; ++n) {
+      const int tensor_index = node.outputs->data[n];
       AllocationInfo* current = &subgraph_allocation_info[tensor_index];
       UpdateLastUsed(current, allocation_scope_count_);
     }
@@ -330,6 +334,20 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
     UpdateFirstCreated(current, allocation_scope_count_);
     UpdateLastUsed(current, allocation_scope_count_);
   }
+
+#ifdef USE_TFLM_GRAPH_FUSION
+  // The intermediate tensors removed by MicroInterpreterGraph::FuseSubgraphs()
+  // are no longer referred to by any node or subgraph boundary: they are never
+  // read or written and take no arena memory.
+  for (size_t i = 0; i < subgraph->tensors()->size(); ++i) {
+    AllocationInfo* current = &subgraph_allocation_info[i];
+    if (current->first_created == kUninitializedLifetime &&
+        current->last_used == kUninitializedLifetime &&
+        current->offline_offset == kOnlinePlannedBuffer) {
+      current->needs_allocating = false;
+    }
+  }
+#endif  // USE_TFLM_GRAPH_FUSION
   return kTfLiteOk;
 }
 
@@ -219,6 +219,12 @@ TfLiteStatus MicroInterpreter::AllocateTensors() {
 
   TF_LITE_ENSURE_STATUS(graph_.PrepareSubgraphs());
 
+#ifdef USE_TFLM_GRAPH_FUSION
+  // Before memory planning, which no longer gives the fused intermediate
+  // tensors a buffer.
+  TF_LITE_ENSURE_STATUS(graph_.FuseSubgraphs());
+#endif  // USE_TFLM_GRAPH_FUSION
+
   micro_context_.SetInterpreterState(
       MicroInterpreterContext::InterpreterState::kMemoryPlanning);
 
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_interpreter_graph.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "flatbuffers/flatbuffers.h"  // from @flatbuffers
 #include "tensorflow/lite/c/common.h"
@@ -77,6 +78,86 @@ int CheckDynamicTensors(const TfLiteIntArray* const tensor_indices,
   return -1;
 }
 
+// Operators whose output FuseSubgraphs() can redirect into the output of
+// their consumer.
+bool IsFusionProducer(const TFLMRegistration* registration) {
+  switch (registration->builtin_code) {
+    case BuiltinOperator_CONV_2D:
+    case BuiltinOperator_DEPTHWISE_CONV_2D:
+    case BuiltinOperator_FULLY_CONNECTED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Elementwise operators: output element i only depends on element i of a
+// same-shaped input (plus broadcast operands), so they can run in place on
+// that input.
+bool IsFusionConsumer(const TFLMRegistration* registration) {
+  switch (registration->builtin_code) {
+    case BuiltinOperator_ADD:
+    case BuiltinOperator_MUL:
+    case BuiltinOperator_RELU:
+    case BuiltinOperator_RELU6:
+    case BuiltinOperator_LEAKY_RELU:
+    case BuiltinOperator_HARD_SWISH:
+    case BuiltinOperator_LOGISTIC:
+    case BuiltinOperator_TANH:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ContainsTensor(const flatbuffers::Vector<int32_t>* tensors,
+                    int tensor_index) {
+  for (size_t i = 0; tensors != nullptr && i < tensors->size(); ++i) {
+    if (tensors->Get(i) == tensor_index) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ContainsTensor(const TfLiteIntArray* tensors, int tensor_index) {
+  for (int i = 0; tensors != nullptr && i < tensors->size; ++i) {
+    if (tensors->data[i] == tensor_index) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Offline planned offsets are per tensor, so an intermediate tensor can't be
+// merged into another one (see micro/docs/memory_management.md).
+bool HasOfflineMemoryPlan(const Model* model) {
+  constexpr char kOfflineMemAllocMetadata[] = "OfflineMemoryAllocation";
+  const auto* metadata = model->metadata();
+  for (size_t i = 0; metadata != nullptr && i < metadata->size(); ++i) {
+    const auto* name = metadata->Get(i)->name();
+    if (name != nullptr && name->size() == strlen(kOfflineMemAllocMetadata) &&
+        strncmp(name->c_str(), kOfflineMemAllocMetadata, name->size()) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns a persistent copy of array that a graph pass can modify (node
+// arrays point into the flatbuffer).
+TfLiteIntArray* CopyIntArray(MicroAllocator* allocator,
+                             const TfLiteIntArray* array) {
+  TfLiteIntArray* copy =
+      static_cast<TfLiteIntArray*>(allocator->AllocatePersistentBuffer(
+          TfLiteIntArrayGetSizeInBytes(array->size)));
+  if (copy != nullptr) {
+    copy->size = array->size;
+    std::copy(array->data, array->data + array->size, copy->data);
+  }
+  return copy;
+}
+
 }  // namespace
 
 MicroInterpreterGraph::MicroInterpreterGraph(
@@ -182,6 +263,87 @@ TfLiteStatus MicroInterpreterGraph::PrepareSubgraphs() {
   return kTfLiteOk;
 }
 
+TfLiteStatus MicroInterpreterGraph::FuseSubgraphs() {
+  // A preserved intermediate tensor must keep its own buffer.
+  if (allocator_->preserves_all_tensor() || HasOfflineMemoryPlan(model_)) {
+    return kTfLiteOk;
+  }
+
+  for (size_t subgraph_idx = 0; subgraph_idx < subgraphs_->size();
+       subgraph_idx++) {
+    const SubGraph* subgraph = (*subgraphs_)[subgraph_idx];
+    NodeAndRegistration* nodes =
+        subgraph_allocations_[subgraph_idx].node_and_registrations;
+    const TfLiteEvalTensor* tensors =
+        subgraph_allocations_[subgraph_idx].tensors;
+    uint32_t operators_size = NumSubgraphOperators(model_, subgraph_idx);
+
+    for (uint32_t producer_idx = 0; producer_idx < operators_size;
+         ++producer_idx) {
+      TfLiteNode* producer = &nodes[producer_idx].node;
+      if (!IsFusionProducer(nodes[producer_idx].registration) ||
+          producer->outputs == nullptr || producer->outputs->size != 1) {
+        continue;
+      }
+      const int intermediate = producer->outputs->data[0];
+      if (ContainsTensor(subgraph->inputs(), intermediate) ||
+          ContainsTensor(subgraph->outputs(), intermediate) ||
+          subgraph->tensors()->Get(intermediate)->is_variable()) {
+        continue;
+      }
+
+      // The intermediate tensor must be read exactly once, by an
+      // elementwise operator.
+      int uses = 0;
+      uint32_t consumer_idx = 0;
+      int consumer_input = 0;
+      for (uint32_t i = 0; i < operators_size; ++i) {
+        const TfLiteIntArray* inputs = nodes[i].node.inputs;
+        for (int n = 0; inputs != nullptr && n < inputs->size; ++n) {
+          if (inputs->data[n] == intermediate) {
+            uses++;
+            consumer_idx = i;
+            consumer_input = n;
+          }
+        }
+      }
+      if (uses != 1 || consumer_idx <= producer_idx ||
+          !IsFusionConsumer(nodes[consumer_idx].registration)) {
+        continue;
+      }
+      TfLiteNode* consumer = &nodes[consumer_idx].node;
+      if (consumer->outputs == nullptr || consumer->outputs->size != 1) {
+        continue;
+      }
+      const int output = consumer->outputs->data[0];
+      // In place needs the same bytes for the same elements. A consumer
+      // already reading its own output has been fused with another producer
+      // (e.g. ADD of two convolutions) and must keep its other input.
+      if (subgraph->tensors()->Get(output)->is_variable() ||
+          tensors[output].type != tensors[intermediate].type ||
+          !TfLiteIntArrayEqual(tensors[output].dims,
+                               tensors[intermediate].dims) ||
+          ContainsTensor(consumer->inputs, output)) {
+        continue;
+      }
+
+      TfLiteIntArray* producer_outputs =
+          CopyIntArray(allocator_, producer->outputs);
+      TfLiteIntArray* consumer_inputs =
+          CopyIntArray(allocator_, consumer->inputs);
+      if (producer_outputs == nullptr || consumer_inputs == nullptr) {
+        MicroPrintf("Failed to allocate memory for operator fusion");
+        return kTfLiteError;
+      }
+      producer_outputs->data[0] = output;
+      consumer_inputs->data[consumer_input] = output;
+      producer->outputs = producer_outputs;
+      consumer->inputs = consumer_inputs;
+    }
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus MicroInterpreterGraph::ResetSubgraphs() {
   int previous_subgraph_idx = current_subgraph_index_;
   uint32_t previous_operator_idx = current_operator_index_;
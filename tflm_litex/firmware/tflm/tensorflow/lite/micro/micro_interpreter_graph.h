@@ -47,6 +47,15 @@ class MicroInterpreterGraph : public MicroGraph {
   // in the model.
   virtual TfLiteStatus PrepareSubgraphs();
 
+  // Fuses each CONV_2D, DEPTHWISE_CONV_2D or FULLY_CONNECTED operator with
+  // the elementwise operator (ADD, MUL or an activation) that is the only
+  // reader of its output: the producer writes straight into the consumer's
+  // output tensor and the consumer runs in place on it, so the intermediate
+  // tensor gets no arena memory. Runs after PrepareSubgraphs() and before
+  // memory planning; does nothing when all tensors are preserved or the
+  // model has an offline memory plan.
+  virtual TfLiteStatus FuseSubgraphs();
+
   // Calls TFLMRegistration->Reset for every operator in every subgraph in
   // the model.
   virtual TfLiteStatus ResetSubgraphs();
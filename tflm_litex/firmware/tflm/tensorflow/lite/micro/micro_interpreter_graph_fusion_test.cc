@@ -0,0 +1,327 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Host-side test of MicroInterpreterGraph::FuseSubgraphs() on random int8
+// models with conv -> RELU, depthwise conv -> ADD, ADD of two convs (only
+// one of them can be fused) and fully connected -> LOGISTIC.
+//
+// Every model is also run by an interpreter that preserves all tensors, which
+// never fuses, and the outputs must be bit-exact. Built with
+// USE_TFLM_GRAPH_FUSION the fused intermediate tensors must get no arena
+// buffer; without it every intermediate tensor must keep its own.
+// Built and run by `make test` in the TFLM directory, once with and once
+// without -DUSE_TFLM_GRAPH_FUSION.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "flatbuffers/flatbuffers.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+
+constexpr int kArenaSize = 64 * 1024;
+alignas(16) uint8_t fused_arena[kArenaSize];
+alignas(16) uint8_t preserved_arena[kArenaSize];
+
+int Uniform(std::mt19937& rng, int lo, int hi) {
+  return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+// Exposes the eval tensors, which MicroInterpreter::GetTensor() only returns
+// when all tensors are preserved.
+class TestInterpreter : public tflite::MicroInterpreter {
+ public:
+  using tflite::MicroInterpreter::MicroInterpreter;
+
+  // The arena buffer of a tensor, nullptr when it has none.
+  const void* TensorData(int tensor_index) {
+    return context().GetEvalTensor(&context(), tensor_index)->data.data;
+  }
+};
+
+// Writes an int8 model with random weights and quantization into a
+// flatbuffer.
+class ModelBuilder {
+ public:
+  explicit ModelBuilder(std::mt19937& rng)
+      : rng_(rng), fbb_(1024, &allocator_) {
+    // Buffer 0 is the empty buffer of the tensors without data.
+    buffers_.push_back(tflite::CreateBuffer(fbb_));
+  }
+
+  int Activation(std::vector<int> shape, float scale, int zero_point) {
+    return AddTensor(shape, tflite::TensorType_INT8, {scale}, {zero_point});
+  }
+
+  // SAME-padded 3x3 conv over an 8x8 input; returns its output tensor.
+  int Conv(int input, int input_depth, int output_depth) {
+    const int filter =
+        Filter({output_depth, 3, 3, input_depth}, output_depth, 0);
+    const int bias = Bias(output_depth);
+    const int output =
+        Activation({1, 8, 8, output_depth}, 0.05f, Uniform(rng_, -20, 20));
+    AddOperator(tflite::BuiltinOperator_CONV_2D, {input, filter, bias},
+                {output}, tflite::BuiltinOptions_Conv2DOptions,
+                tflite::CreateConv2DOptions(fbb_, tflite::Padding_SAME, 1, 1)
+                    .Union());
+    return output;
+  }
+
+  void DepthwiseConv(int input, int depth, int output) {
+    const int filter = Filter({1, 3, 3, depth}, depth, 3);
+    const int bias = Bias(depth);
+    AddOperator(tflite::BuiltinOperator_DEPTHWISE_CONV_2D,
+                {input, filter, bias}, {output},
+                tflite::BuiltinOptions_DepthwiseConv2DOptions,
+                tflite::CreateDepthwiseConv2DOptions(
+                    fbb_, tflite::Padding_SAME, 1, 1, 1)
+                    .Union());
+  }
+
+  void FullyConnected(int input, int input_size, int output_size,
+                      int output) {
+    const int filter = Filter({output_size, input_size}, output_size, 0);
+    const int bias = Bias(output_size);
+    AddOperator(tflite::BuiltinOperator_FULLY_CONNECTED,
+                {input, filter, bias}, {output},
+                tflite::BuiltinOptions_FullyConnectedOptions,
+                tflite::CreateFullyConnectedOptions(fbb_).Union());
+  }
+
+  void Add(int input1, int input2, int output) {
+    AddOperator(tflite::BuiltinOperator_ADD, {input1, input2}, {output},
+                tflite::BuiltinOptions_AddOptions,
+                tflite::CreateAddOptions(fbb_).Union());
+  }
+
+  void Unary(tflite::BuiltinOperator op, int input, int output) {
+    AddOperator(op, {input}, {output});
+  }
+
+  const tflite::Model* Finish(int input, std::vector<int> outputs) {
+    const auto subgraph = tflite::CreateSubGraph(
+        fbb_, fbb_.CreateVector(tensors_),
+        fbb_.CreateVector(std::vector<int>{input}),
+        fbb_.CreateVector(outputs), fbb_.CreateVector(operators_));
+    fbb_.Finish(tflite::CreateModel(
+                    fbb_, 3, fbb_.CreateVector(codes_),
+                    fbb_.CreateVector(std::vector<
+                                      flatbuffers::Offset<tflite::SubGraph>>{
+                        subgraph}),
+                    0, fbb_.CreateVector(buffers_)),
+                tflite::ModelIdentifier());
+    return tflite::GetModel(fbb_.GetBufferPointer());
+  }
+
+ private:
+  int AddTensor(std::vector<int> shape, tflite::TensorType type,
+                std::vector<float> scale, std::vector<int64_t> zero_point,
+                int buffer = 0, int quantized_dimension = 0) {
+    const auto quantization = tflite::CreateQuantizationParameters(
+        fbb_, 0, 0, fbb_.CreateVector(scale), fbb_.CreateVector(zero_point),
+        tflite::QuantizationDetails_NONE, 0, quantized_dimension);
+    tensors_.push_back(tflite::CreateTensor(fbb_, fbb_.CreateVector(shape),
+                                            type, buffer, 0, quantization));
+    return tensors_.size() - 1;
+  }
+
+  template <typename T>
+  int AddBuffer(const std::vector<T>& data) {
+    buffers_.push_back(tflite::CreateBuffer(
+        fbb_,
+        fbb_.CreateVector(reinterpret_cast<const uint8_t*>(data.data()),
+                          data.size() * sizeof(T))));
+    return buffers_.size() - 1;
+  }
+
+  // Per-channel symmetric weights along quantized_dimension.
+  int Filter(std::vector<int> shape, int channels, int quantized_dimension) {
+    int size = 1;
+    for (int d : shape) size *= d;
+    std::vector<int8_t> weights(size);
+    for (auto& v : weights) v = Uniform(rng_, -127, 127);
+    std::vector<float> scale(channels);
+    for (auto& v : scale) v = Uniform(rng_, 1, 20) / 1000.0f;
+    return AddTensor(shape, tflite::TensorType_INT8, scale,
+                     std::vector<int64_t>(channels, 0), AddBuffer(weights),
+                     quantized_dimension);
+  }
+
+  int Bias(int channels) {
+    std::vector<int32_t> bias(channels);
+    for (auto& v : bias) v = Uniform(rng_, -2000, 2000);
+    return AddTensor({channels}, tflite::TensorType_INT32,
+                     std::vector<float>(channels, 1e-4f),
+                     std::vector<int64_t>(channels, 0), AddBuffer(bias));
+  }
+
+  int OperatorCode(tflite::BuiltinOperator op) {
+    for (size_t i = 0; i < code_ops_.size(); ++i) {
+      if (code_ops_[i] == op) return i;
+    }
+    code_ops_.push_back(op);
+    codes_.push_back(tflite::CreateOperatorCode(
+        fbb_, static_cast<int8_t>(op), 0, 1, op));
+    return codes_.size() - 1;
+  }
+
+  void AddOperator(tflite::BuiltinOperator op, std::vector<int> inputs,
+                   std::vector<int> outputs,
+                   tflite::BuiltinOptions options_type =
+                       tflite::BuiltinOptions_NONE,
+                   flatbuffers::Offset<void> options = 0) {
+    operators_.push_back(tflite::CreateOperator(
+        fbb_, OperatorCode(op), fbb_.CreateVector(inputs),
+        fbb_.CreateVector(outputs), options_type, options));
+  }
+
+  std::mt19937& rng_;
+  flatbuffers::DefaultAllocator allocator_;
+  flatbuffers::FlatBufferBuilder fbb_;
+  std::vector<flatbuffers::Offset<tflite::Buffer>> buffers_;
+  std::vector<flatbuffers::Offset<tflite::Tensor>> tensors_;
+  std::vector<flatbuffers::Offset<tflite::Operator>> operators_;
+  std::vector<flatbuffers::Offset<tflite::OperatorCode>> codes_;
+  std::vector<tflite::BuiltinOperator> code_ops_;
+};
+
+// Producer outputs that FuseSubgraphs() merges into their consumer's output,
+// and the one it must leave alone.
+struct Intermediates {
+  std::vector<int> fused;
+  int kept;
+};
+
+const tflite::Model* BuildModel(ModelBuilder& builder,
+                                Intermediates* intermediates) {
+  const int input = builder.Activation({1, 8, 8, 3}, 0.02f, -5);
+  const int conv = builder.Conv(input, 3, 4);
+  const int relu = builder.Activation({1, 8, 8, 4}, 0.03f, -128);
+  builder.Unary(tflite::BuiltinOperator_RELU, conv, relu);
+  // The RELU output is read twice and is not a producer: it stays.
+  const int depthwise = builder.Activation({1, 8, 8, 4}, 0.04f, 3);
+  builder.DepthwiseConv(relu, 4, depthwise);
+  const int residual = builder.Activation({1, 8, 8, 4}, 0.06f, 0);
+  builder.Add(depthwise, relu, residual);
+  // Once the first conv writes into the ADD output, the second one must keep
+  // its own buffer.
+  const int conv_a = builder.Conv(residual, 4, 4);
+  const int conv_b = builder.Conv(residual, 4, 4);
+  const int sum = builder.Activation({1, 8, 8, 4}, 0.08f, 1);
+  builder.Add(conv_a, conv_b, sum);
+  const int fully_connected = builder.Activation({1, 10}, 0.1f, 2);
+  builder.FullyConnected(sum, 256, 10, fully_connected);
+  const int logistic = builder.Activation({1, 10}, 1 / 256.0f, -128);
+  builder.Unary(tflite::BuiltinOperator_LOGISTIC, fully_connected, logistic);
+
+  intermediates->fused = {conv, depthwise, conv_a, fully_connected};
+  intermediates->kept = conv_b;
+  return builder.Finish(input, {logistic, residual});
+}
+
+// Returns the number of failed checks.
+int CheckModel(std::mt19937& rng, long* outputs) {
+  ModelBuilder builder(rng);
+  Intermediates intermediates;
+  const tflite::Model* model = BuildModel(builder, &intermediates);
+
+  tflite::MicroMutableOpResolver<6> resolver;
+  resolver.AddConv2D();
+  resolver.AddDepthwiseConv2D();
+  resolver.AddFullyConnected();
+  resolver.AddAdd();
+  resolver.AddRelu();
+  resolver.AddLogistic();
+  TestInterpreter fused(model, resolver, fused_arena, kArenaSize);
+  TestInterpreter preserved(model, resolver, preserved_arena, kArenaSize,
+                            nullptr, nullptr, /*preserve_all_tensors=*/true);
+  if (fused.AllocateTensors() != kTfLiteOk ||
+      preserved.AllocateTensors() != kTfLiteOk) {
+    std::printf(">> FAIL: AllocateTensors\n");
+    return 1;
+  }
+
+  int errors = 0;
+#ifdef USE_TFLM_GRAPH_FUSION
+  const bool expect_fused = true;
+#else
+  const bool expect_fused = false;
+#endif
+  for (int tensor : intermediates.fused) {
+    if ((fused.TensorData(tensor) == nullptr) != expect_fused) {
+      std::printf(">> FAIL: tensor %d %s an arena buffer\n", tensor,
+                  expect_fused ? "has" : "has no");
+      errors++;
+    }
+  }
+  if (fused.TensorData(intermediates.kept) == nullptr) {
+    std::printf(">> FAIL: tensor %d has no arena buffer\n", intermediates.kept);
+    errors++;
+  }
+
+  for (int run = 0; run < 3; ++run) {
+    TfLiteTensor* input = fused.input(0);
+    for (size_t i = 0; i < input->bytes; ++i) {
+      input->data.int8[i] = Uniform(rng, -128, 127);
+    }
+    std::memcpy(preserved.input(0)->data.raw, input->data.raw, input->bytes);
+    if (fused.Invoke() != kTfLiteOk || preserved.Invoke() != kTfLiteOk) {
+      std::printf(">> FAIL: Invoke\n");
+      return errors + 1;
+    }
+    for (size_t n = 0; n < fused.outputs_size(); ++n) {
+      const TfLiteTensor* actual = fused.output(n);
+      const TfLiteTensor* expected = preserved.output(n);
+      for (size_t i = 0; i < expected->bytes; ++i) {
+        if (actual->data.int8[i] != expected->data.int8[i]) {
+          std::printf(">> FAIL: output %zu[%zu] = %d, expected %d\n", n, i,
+                      actual->data.int8[i], expected->data.int8[i]);
+          errors++;
+          break;
+        }
+      }
+      *outputs += expected->bytes;
+    }
+  }
+  return errors;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+  std::mt19937 rng(argc > 2 ? std::atoi(argv[2]) : 1);
+
+  int failed = 0;
+  long outputs = 0;
+  for (int i = 0; i < iterations; ++i) {
+    if (CheckModel(rng, &outputs) != 0) failed++;
+  }
+  if (failed == 0) {
+    std::printf(">> PASS: %d models, %ld outputs bit-exact with the unfused "
+                "graph\n",
+                iterations, outputs);
+    return EXIT_SUCCESS;
+  }
+  std::printf(">> FAIL: %d of %d models differ\n", failed, iterations);
+  return EXIT_FAILURE;
+}
@@ -27,12 +27,21 @@ from litedram.phy import GENSDRPHY, HalfRateGENSDRPHY
 
 from liteeth.phy.ecp5rgmii import LiteEthPHYRGMII
 
+# O acelerador de produto escalar fica em ../accelerator (mesmo repositório).
+import os
+import sys
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "accelerator", "litex"))
+from accelerator import Accelerator, accel_csr_paging
+
 # CRG ----------------------------------------------------------------------------------------------
 
 class _CRG(LiteXModule):
-    def __init__(self, platform, sys_clk_freq, use_internal_osc=False, with_usb_pll=False, with_video_pll=False, sdram_rate="1:1"):
+    def __init__(self, platform, sys_clk_freq, use_internal_osc=False, with_usb_pll=False, with_video_pll=False, sdram_rate="1:1",
+        accel_clk_freq=None):
         self.rst    = Signal()
         self.cd_sys = ClockDomain()
+        if accel_clk_freq is not None:
+            self.cd_accel = ClockDomain()
         if sdram_rate == "1:2":
             self.cd_sys2x    = ClockDomain()
             self.cd_sys2x_ps = ClockDomain()
@@ -66,6 +75,9 @@ class _CRG(LiteXModule):
             pll.create_clkout(self.cd_sys2x_ps, 2*sys_clk_freq, phase=180) # Idealy 90° but needs to be increased.
         else:
            pll.create_clkout(self.cd_sys_ps, sys_clk_freq, phase=180) # Idealy 90° but needs to be increased.
+        # Clock próprio do núcleo do acelerador (--accel-clk-freq), independente do da CPU
+        if accel_clk_freq is not None:
+            pll.create_clkout(self.cd_accel, accel_clk_freq)
 
         # USB PLL
         if with_usb_pll:
@@ -105,6 +117,14 @@ class BaseSoC(SoCCore):
         sdram_rate             = "1:1",
         with_video_terminal    = False,
         with_video_framebuffer = False,
+        with_accelerator       = False,
+        accel_vector_len       = 8,
+        accel_pipelined        = False,
+        accel_dma              = False,
+        accel_int8             = False,
+        accel_requant          = False,
+        accel_sticky           = False,
+        accel_clk_freq         = None,
         **kwargs):
         board = board.lower()
         assert board in ["i5", "i9"]
@@ -117,9 +137,25 @@ class BaseSoC(SoCCore):
             use_internal_osc = use_internal_osc,
             with_usb_pll     = with_usb_pll,
             with_video_pll   = with_video_pll,
-            sdram_rate       = sdram_rate
+            sdram_rate       = sdram_rate,
+            accel_clk_freq   = accel_clk_freq if with_accelerator else None
         )
 
+        # Accelerator ------------------------------------------------------------------------------
+        # Usado pelo kernel FullyConnected da plataforma (firmware/platform/litex_fully_connected.cc).
+        # Construído antes do SoCCore: a página de CSR depende dos CSRs que ele gera (ver
+        # accel_csr_paging). Com --accel-clk-freq o núcleo roda no domínio `accel` (ver AcceleratorCDC).
+        if with_accelerator:
+            accelerator = Accelerator(platform,
+                vector_len   = accel_vector_len,
+                pipelined    = accel_pipelined,
+                with_dma     = accel_dma or accel_int8,
+                with_int8    = accel_int8,
+                with_requant = accel_requant,
+                with_sticky  = accel_sticky,
+                clock_domain = "sys" if accel_clk_freq is None else "accel")
+            kwargs["csr_paging"] = accel_csr_paging([accelerator], kwargs.get("csr_paging", 0x800))
+
         # SoCCore ----------------------------------------------------------------------------------
         SoCCore.__init__(self, platform, int(sys_clk_freq), ident = "LiteX SoC on Colorlight " + board.upper(), **kwargs)
         
@@ -128,6 +164,15 @@ class BaseSoC(SoCCore):
             ledn = platform.request_all("user_led_n")
             self.leds = LedChaser(pads=ledn, sys_clk_freq=sys_clk_freq)
 
+        if with_accelerator:
+            if accel_clk_freq is not None:
+                self.platform.add_false_path_constraints(self.crg.cd_sys.clk, self.crg.cd_accel.clk)
+                self.add_constant("ACCELERATOR_CLK_FREQ", int(accel_clk_freq))
+            self.accelerator = accelerator
+            if accel_dma or accel_int8:
+                self.bus.add_master(name="accelerator_dma", master=self.accelerator.dma.bus)
+            self.add_constant("ACCELERATOR_VECTOR_LEN", accel_vector_len)
+
         # SPI Flash --------------------------------------------------------------------------------
         if board == "i5":
             from litespi.modules import GD25Q16 as SpiFlashModule
@@ -202,6 +247,14 @@ def main():
     viopts = parser.target_group.add_mutually_exclusive_group()
     viopts.add_argument("--with-video-terminal",    action="store_true", help="Enable Video Terminal (HDMI).")
     viopts.add_argument("--with-video-framebuffer", action="store_true", help="Enable Video Framebuffer (HDMI).")
+    parser.add_target_argument("--with-accelerator", action="store_true", help="Add the dot-product accelerator (FullyConnected offload).")
+    parser.add_target_argument("--accel-vector-len", default=8, type=int, help="Accelerator vector length (elements per job).")
+    parser.add_target_argument("--accel-pipelined",  action="store_true", help="Use the pipelined accelerator datapath.")
+    parser.add_target_argument("--accel-dma",        action="store_true", help="Add the accelerator Wishbone DMA front-end.")
+    parser.add_target_argument("--accel-int8",       action="store_true", help="Add the INT8 packed DMA mode (implies --accel-dma).")
+    parser.add_target_argument("--accel-requant",    action="store_true", help="Requantize layer outputs in hardware (bias, multiplier, offset, clamp).")
+    parser.add_target_argument("--accel-sticky",     action="store_true", help="Add the sticky-result mode (no start/done round trip between jobs).")
+    parser.add_target_argument("--accel-clk-freq",   default=None, type=float, help="Run the accelerator core in its own clock domain at this frequency.")
     args = parser.parse_args()
 
     soc = BaseSoC(board=args.board, revision=args.revision,
@@ -216,6 +269,14 @@ def main():
         sdram_rate             = args.sdram_rate,
         with_video_terminal    = args.with_video_terminal,
         with_video_framebuffer = args.with_video_framebuffer,
+        with_accelerator       = args.with_accelerator,
+        accel_vector_len       = args.accel_vector_len,
+        accel_pipelined        = args.accel_pipelined,
+        accel_dma              = args.accel_dma,
+        accel_int8             = args.accel_int8,
+        accel_requant          = args.accel_requant,
+        accel_sticky           = args.accel_sticky,
+        accel_clk_freq         = args.accel_clk_freq,
         **parser.soc_argdict
     )
     soc.platform.add_extension(colorlight_i5._sdcard_pmod_io)
@@ -225,6 +286,8 @@ def main():
         soc.add_sdcard()
 
     builder = Builder(soc, **parser.builder_argdict)
+    if args.with_accelerator:
+        soc.accelerator.generate_driver(builder.generated_dir)
     if args.build:
         builder.build(**parser.toolchain_argdict)
 